@@ -0,0 +1,348 @@
+#include "mayaMVG/geometry/MVGGeometry.hpp"
+#include "mayaMVG/geometry/MVGSpatialGrid.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Microbenchmarks of the geometry hot paths, run on synthetic scenes.
+ * Usage: mayaMVGBenchmark [filter] (only run benchmarks whose name contains filter)
+ */
+
+using namespace mayaMVG;
+
+namespace
+{ // empty namespace
+
+// Keeps benchmark results alive, so that the compiler does not remove the computations
+volatile double g_sink = 0.0;
+
+// Minimum running time of each benchmark, in seconds
+const double kMinTime = 0.5;
+
+class MVGBenchmark
+{
+public:
+    MVGBenchmark(const std::string& name, const std::vector<int>& sizes)
+        : _name(name)
+        , _sizes(sizes)
+    {
+    }
+    virtual ~MVGBenchmark() {}
+
+    const std::string& getName() const { return _name; }
+    const std::vector<int>& getSizes() const { return _sizes; }
+
+    virtual void setUp(const int size) = 0;
+    // Runs a single iteration
+    virtual void run() = 0;
+
+private:
+    std::string _name;
+    std::vector<int> _sizes;
+};
+
+std::vector<int> sizes(const int a, const int b, const int c, const int d = 0)
+{
+    std::vector<int> result;
+    result.push_back(a);
+    result.push_back(b);
+    result.push_back(c);
+    if(d > 0)
+        result.push_back(d);
+    return result;
+}
+
+/**
+ * Vertex picking as done by MVGManipulatorCache: one query per mouse position, the first
+ * vertex in the tolerance box wins.
+ */
+class PointPickingBenchmark : public MVGBenchmark
+{
+public:
+    PointPickingBenchmark(const bool useGrid)
+        : MVGBenchmark(useGrid ? "PointPicking/grid" : "PointPicking/linear",
+                       sizes(10000, 100000, 1000000))
+        , _useGrid(useGrid)
+    {
+    }
+
+    void setUp(const int size)
+    {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        _xs.resize(size);
+        _ys.resize(size);
+        for(int i = 0; i < size; ++i)
+        {
+            _xs[i] = distribution(generator);
+            _ys[i] = distribution(generator);
+        }
+        _mouseXs.resize(kQueryCount);
+        _mouseYs.resize(kQueryCount);
+        for(int i = 0; i < kQueryCount; ++i)
+        {
+            _mouseXs[i] = distribution(generator);
+            _mouseYs[i] = distribution(generator);
+        }
+        _grid.clear();
+        if(!_useGrid)
+            return;
+        _grid.reset(-1.0, -1.0, 1.0, 1.0, size);
+        for(int i = 0; i < size; ++i)
+            _grid.insert(i, _xs[i], _ys[i]);
+    }
+
+    void run()
+    {
+        const double threshold = 0.001;
+        int picked = 0;
+        for(int q = 0; q < kQueryCount; ++q)
+        {
+            const double mouseX = _mouseXs[q];
+            const double mouseY = _mouseYs[q];
+            if(_useGrid)
+            {
+                _grid.query(mouseX - threshold, mouseY - threshold, mouseX + threshold,
+                            mouseY + threshold, _candidates);
+                for(size_t i = 0; i < _candidates.size(); ++i)
+                {
+                    if(isInside(_candidates[i], mouseX, mouseY, threshold))
+                    {
+                        picked += _candidates[i];
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                for(size_t i = 0; i < _xs.size(); ++i)
+                {
+                    if(isInside(i, mouseX, mouseY, threshold))
+                    {
+                        picked += i;
+                        break;
+                    }
+                }
+            }
+        }
+        g_sink = g_sink + picked;
+    }
+
+private:
+    bool isInside(const int i, const double mouseX, const double mouseY,
+                  const double threshold) const
+    {
+        return mouseX <= _xs[i] + threshold && mouseX >= _xs[i] - threshold &&
+               mouseY <= _ys[i] + threshold && mouseY >= _ys[i] - threshold;
+    }
+
+private:
+    static const int kQueryCount = 100;
+    bool _useGrid;
+    std::vector<double> _xs;
+    std::vector<double> _ys;
+    std::vector<double> _mouseXs;
+    std::vector<double> _mouseYs;
+    MVGSpatialGrid _grid;
+    std::vector<int> _candidates;
+};
+
+/**
+ * Plane fitting on noisy points of a plane, with 20% outliers.
+ */
+class ComputePlaneBenchmark : public MVGBenchmark
+{
+public:
+    ComputePlaneBenchmark(const MVGPlaneEstimatorOptions::EMethod method, const std::string& name)
+        : MVGBenchmark("ComputePlane/" + name, sizes(10, 100, 1000, 10000))
+    {
+        _options.method = method;
+    }
+
+    void setUp(const int size)
+    {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        std::normal_distribution<double> noise(0.0, 0.01);
+        _points.resize(3, size);
+        for(int i = 0; i < size; ++i)
+        {
+            const double x = distribution(generator);
+            const double y = distribution(generator);
+            const double z = (i % 5 == 0) ? distribution(generator)
+                                          : 0.5 * x - 0.2 * y + 1.0 + noise(generator);
+            _points.col(i) = aliceVision::Vec3(x, y, z);
+        }
+    }
+
+    void run()
+    {
+        PlaneKernel::Model model;
+        MVGGeometry::computePlane(_points, model, _options);
+        g_sink = g_sink + model(3);
+    }
+
+private:
+    MVGPlaneEstimatorOptions _options;
+    aliceVision::Mat _points;
+};
+
+/**
+ * Point cloud items enclosed in a face, as done by MVGPointCloud::projectPoints: project every
+ * item in view space and run the winding number test.
+ */
+class PolygonEnclosureBenchmark : public MVGBenchmark
+{
+public:
+    PolygonEnclosureBenchmark()
+        : MVGBenchmark("PolygonEnclosure", sizes(1000, 10000, 100000))
+    {
+    }
+
+    void setUp(const int size)
+    {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        _points.resize(3, size);
+        for(int i = 0; i < size; ++i)
+            _points.col(i) = aliceVision::Vec3(distribution(generator), distribution(generator),
+                                               -5.0 + distribution(generator));
+        // perspective projection looking down -Z (row vector convention)
+        _projection = MVGViewProjection();
+        double(*m)[4] = _projection.worldToClip;
+        m[2][2] = -1.0;
+        m[2][3] = -1.0;
+        m[3][2] = -0.2;
+        m[3][3] = 0.0;
+        _projection.viewportWidth = 1920.0;
+        _projection.viewportHeight = 1080.0;
+        // closed quad covering the center of the viewport
+        _polygon.resize(2, 5);
+        _polygon << 700, 1200, 1300, 650, 700, 300, 350, 800, 750, 300;
+    }
+
+    void run()
+    {
+        int enclosed = 0;
+        aliceVision::Vec2 viewPoint;
+        for(int i = 0; i < _points.cols(); ++i)
+        {
+            MVGGeometry::worldToViewSpace(_projection, _points.col(i), viewPoint);
+            if(MVGGeometry::windingNumber(viewPoint, _polygon) != 0)
+                ++enclosed;
+        }
+        g_sink = g_sink + enclosed;
+    }
+
+private:
+    aliceVision::Mat3X _points;
+    aliceVision::Mat2X _polygon;
+    MVGViewProjection _projection;
+};
+
+/**
+ * N-view triangulation of a point seen by cameras placed on a circle.
+ */
+class TriangulationBenchmark : public MVGBenchmark
+{
+public:
+    TriangulationBenchmark()
+        : MVGBenchmark("TriangulatePoint", sizes(2, 8, 32, 128))
+    {
+    }
+
+    void setUp(const int size)
+    {
+        aliceVision::Mat3 K;
+        K << 1000.0, 0.0, 960.0, 0.0, 1000.0, 540.0, 0.0, 0.0, 1.0;
+        const aliceVision::Vec4 point(0.1, 0.2, 0.3, 1.0);
+        _projectionMatrices.resize(size);
+        _imagePoints.resize(2, size);
+        for(int i = 0; i < size; ++i)
+        {
+            // camera on a circle of radius 10, looking at the origin
+            const double angle = 2.0 * M_PI * i / size;
+            const aliceVision::Vec3 C(10.0 * std::cos(angle), 0.0, 10.0 * std::sin(angle));
+            const aliceVision::Vec3 forward = -C.normalized();
+            const aliceVision::Vec3 right = aliceVision::Vec3(0.0, 1.0, 0.0).cross(forward);
+            aliceVision::Mat3 R;
+            R.row(0) = right;
+            R.row(1) = forward.cross(right);
+            R.row(2) = forward;
+            MVGGeometry::computeProjectionMatrix(K, R, C, _projectionMatrices[i]);
+            const aliceVision::Vec3 projected = _projectionMatrices[i] * point;
+            _imagePoints.col(i) = projected.head<2>() / projected(2);
+        }
+    }
+
+    void run()
+    {
+        aliceVision::Vec3 triangulated;
+        MVGGeometry::triangulatePoint(_imagePoints, _projectionMatrices, triangulated);
+        g_sink = g_sink + triangulated(0);
+    }
+
+private:
+    std::vector<aliceVision::Mat34> _projectionMatrices;
+    aliceVision::Mat2X _imagePoints;
+};
+
+void runBenchmark(MVGBenchmark& benchmark)
+{
+    typedef std::chrono::steady_clock Clock;
+    const std::vector<int>& benchmarkSizes = benchmark.getSizes();
+    for(size_t s = 0; s < benchmarkSizes.size(); ++s)
+    {
+        const int size = benchmarkSizes[s];
+        benchmark.setUp(size);
+        // increase the number of iterations until the minimum running time is reached
+        long iterations = 1;
+        double elapsed = 0.0;
+        while(true)
+        {
+            const Clock::time_point start = Clock::now();
+            for(long i = 0; i < iterations; ++i)
+                benchmark.run();
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            if(elapsed >= kMinTime || iterations >= 1000000000L)
+                break;
+            iterations *= (elapsed > 0.0) ? std::max(2L, (long)(1.4 * kMinTime / elapsed)) : 10L;
+        }
+        const std::string name = benchmark.getName() + "/" + std::to_string(size);
+        std::printf("%-32s %14.0f ns %12ld\n", name.c_str(), 1e9 * elapsed / iterations,
+                    iterations);
+    }
+}
+
+} // empty namespace
+
+int main(int argc, char** argv)
+{
+    const char* filter = (argc > 1) ? argv[1] : "";
+
+    PointPickingBenchmark linearPicking(false);
+    PointPickingBenchmark gridPicking(true);
+    ComputePlaneBenchmark lmedsComputePlane(MVGPlaneEstimatorOptions::kLMedS, "lmeds");
+    ComputePlaneBenchmark msacComputePlane(MVGPlaneEstimatorOptions::kMsac, "msac");
+    PolygonEnclosureBenchmark polygonEnclosure;
+    TriangulationBenchmark triangulation;
+    MVGBenchmark* benchmarks[] = {&linearPicking,     &gridPicking,      &lmedsComputePlane,
+                                  &msacComputePlane,  &polygonEnclosure, &triangulation};
+
+    std::printf("%-32s %17s %12s\n", "Benchmark", "Time", "Iterations");
+    std::printf("%s\n", std::string(63, '-').c_str());
+    for(size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); ++i)
+    {
+        if(!std::strstr(benchmarks[i]->getName().c_str(), filter))
+            continue;
+        runBenchmark(*benchmarks[i]);
+    }
+    return 0;
+}
@@ -1,8 +1,10 @@
 #include "mayaMVG/core/MVGCamera.hpp"
+#include "mayaMVG/core/MVGCameraRegistry.hpp"
 #include "mayaMVG/core/MVGProject.hpp"
 #include "mayaMVG/core/MVGLog.hpp"
 #include "mayaMVG/core/MVGPointCloud.hpp"
 #include "mayaMVG/core/MVGPointCloudItem.hpp"
+#include "mayaMVG/geometry/MVGVisibilityIndex.hpp"
 #include "mayaMVG/maya/MVGMayaUtil.hpp"
 #include "mayaMVG/maya/cmd/MVGImagePlaneCmd.hpp"
 #include <maya/MPoint.h>
@@ -15,8 +17,9 @@
 #include <maya/MDagModifier.h>
 #include <maya/MFnNumericAttribute.h>
 #include <maya/MFnTypedAttribute.h>
-#include <maya/MItDependencyNodes.h>
+#include <maya/MDoubleArray.h>
 #include <maya/MDagPathArray.h>
+#include <sstream>
 
 namespace mayaMVG
 {
@@ -51,22 +54,8 @@ MVGCamera::MVGCamera(const MDagPath& dagPath)
 MVGCamera::MVGCamera(const int& id)
     : MVGNodeWrapper()
 {
-    MStatus status;
-    MDagPath path;
-    MItDependencyNodes it(MFn::kCamera);
-    for(; !it.isDone(); it.next())
-    {
-        MFnDependencyNode fn(it.thisNode());
-        status = MDagPath::getAPathTo(fn.object(), path);
-        CHECK_RETURN(status)
-        MVGCamera camera(path);
-        if(camera.isValid() && (camera.getId() == id))
-        {
-            status = MDagPath::getAPathTo(fn.object(), _dagpath);
-            return;
-        }
-    }
-    LOG_ERROR("Unable to find camera with id " << id)
+    if(!MVGCameraRegistry::getDagPath(id, _dagpath))
+        LOG_ERROR("Unable to find camera with id " << id)
 }
 
 MVGCamera::~MVGCamera()
@@ -108,50 +97,85 @@ bool MVGCamera::isValid() const
     return true;
 }
 
-MVGCamera MVGCamera::create(MDagPath& cameraDagPath, std::map<int, MIntArray>& itemsPerCamera)
+MVGCamera MVGCamera::create(MDagPath& cameraDagPath, const MVGVisibilityIndex& visibility)
 {
-    MStatus status;
-
     cameraDagPath.extendToShape();
-    MObject cameraNode = cameraDagPath.node();
-
-    MVGCamera camera(cameraDagPath);
+    MDagPathArray cameraDagPaths;
+    cameraDagPaths.append(cameraDagPath);
+    std::vector<MVGCamera> cameras = create(cameraDagPaths, visibility);
+    return cameras.empty() ? MVGCamera(cameraDagPath) : cameras[0];
+}
 
-    // Configure camera
-    MFnCamera fnCamera(cameraDagPath);
-    fnCamera.setPanZoomEnabled(true);
-    // Reset film offset (should not be necessary, but kept for compatibility)
-    fnCamera.setHorizontalFilmOffset((0.0));
-    fnCamera.setVerticalFilmOffset((0.0));
+/**
+ * Configure cameras imported from an Alembic file.
+ * Dynamic attributes are added with a single MDagModifier, and image planes are created with a
+ * single Python call, to keep the import time reasonable with thousands of cameras.
+ *
+ * @param[in] cameraDagPaths : imported cameras (shapes or transforms)
+ * @param[in] visibility : point cloud visibility
+ * @return the configured cameras
+ */
+std::vector<MVGCamera> MVGCamera::create(const MDagPathArray& cameraDagPaths,
+                                         const MVGVisibilityIndex& visibility)
+{
+    std::vector<MVGCamera> cameras;
+    cameras.reserve(cameraDagPaths.length());
 
-    // Add MVG attributes
+    // Configure cameras & add MVG attributes
     MDagModifier dagModifier;
     MFnTypedAttribute tAttr;
-    // Visibility
-    int viewID;
-    MVGMayaUtil::getIntAttribute(cameraNode, "mvg_viewId", viewID);
-    MObject itemsAttr = tAttr.create(MVGCamera::_MVG_ITEMS, "itm", MFnData::kIntArray);
-    dagModifier.addAttribute(cameraNode, itemsAttr);
-    MObject thumbnailAttr = tAttr.create(MVGCamera::_MVG_THUMBNAIL_PATH, "mtp", MFnData::kString);
-    dagModifier.addAttribute(cameraNode, thumbnailAttr);
-    MObject imgSourceAttr =
-        tAttr.create(MVGCamera::_MVG_IMAGE_SOURCE_PATH, "misp", MFnData::kString);
-    dagModifier.addAttribute(cameraNode, imgSourceAttr);
+    for(unsigned int i = 0; i < cameraDagPaths.length(); ++i)
+    {
+        MDagPath cameraDagPath = cameraDagPaths[i];
+        cameraDagPath.extendToShape();
+        if(cameraDagPath.apiType() != MFn::kCamera)
+            continue;
+        MObject cameraNode = cameraDagPath.node();
+
+        MFnCamera fnCamera(cameraDagPath);
+        fnCamera.setPanZoomEnabled(true);
+        // Reset film offset (should not be necessary, but kept for compatibility)
+        fnCamera.setHorizontalFilmOffset((0.0));
+        fnCamera.setVerticalFilmOffset((0.0));
+
+        MObject itemsAttr = tAttr.create(MVGCamera::_MVG_ITEMS, "itm", MFnData::kIntArray);
+        dagModifier.addAttribute(cameraNode, itemsAttr);
+        MObject thumbnailAttr =
+            tAttr.create(MVGCamera::_MVG_THUMBNAIL_PATH, "mtp", MFnData::kString);
+        dagModifier.addAttribute(cameraNode, thumbnailAttr);
+        MObject imgSourceAttr =
+            tAttr.create(MVGCamera::_MVG_IMAGE_SOURCE_PATH, "misp", MFnData::kString);
+        dagModifier.addAttribute(cameraNode, imgSourceAttr);
+        cameras.push_back(MVGCamera(cameraDagPath));
+    }
+    if(cameras.empty())
+        return cameras;
     dagModifier.doIt();
 
     // Set MVG attributes
-    MVGMayaUtil::setIntArrayAttribute(cameraNode, MVGCamera::_MVG_ITEMS, itemsPerCamera[viewID]);
+    MString cameraList;
+    for(std::vector<MVGCamera>::const_iterator it = cameras.begin(); it != cameras.end(); ++it)
+    {
+        // Visibility
+        const int* points = NULL;
+        const int count = visibility.getPoints(visibility.getSlot(it->getId()), points);
+        MIntArray items;
+        if(count > 0)
+            items = MIntArray(points, count);
+        MVGMayaUtil::setIntArrayAttribute(it->getObject(), MVGCamera::_MVG_ITEMS, items);
+        cameraList += "'" + it->getDagPath().fullPathName() + "',";
+    }
 
-    // create, reparent & connect image plane
+    // create, reparent & connect image planes
     MString cmd;
     MGlobal::executePythonCommand("from mayaMVG import camera");
-    MString fileName = "";
-    cmd.format("camera.mvgSetImagePlane(\'^1s\', \'^2s\')", cameraDagPath.fullPathName(), fileName);
+    cmd.format("camera.mvgSetImagePlanes([^1s])", cameraList);
     MGlobal::executePythonCommand(cmd);
 
-    // Configure image plane
-    camera.setImagePlane();
-    return camera;
+    // Configure image planes
+    for(std::vector<MVGCamera>::const_iterator it = cameras.begin(); it != cameras.end(); ++it)
+        it->setImagePlane();
+    return cameras;
 }
 
 /**
@@ -194,6 +218,40 @@ void MVGCamera::setId(const int& id) const
     MStatus status;
     status = MVGMayaUtil::setIntAttribute(_dagpath.node(), _MVG_VIEW_ID, id);
     CHECK(status)
+    MVGCameraRegistry::invalidate();
+}
+
+/**
+ * Keep the image path read from the Alembic file as image source, and point the image and
+ * thumbnail paths to the undistorted images of the project.
+ *
+ * @param[in] projectDirectory : directory of the Alembic file
+ */
+void MVGCamera::setImagesPaths(const std::string& projectDirectory) const
+{
+    MString originalImagePath;
+    MStatus status = MVGMayaUtil::getStringAttribute(_dagpath.node(), _MVG_IMAGE_PATH,
+                                                     originalImagePath);
+    CHECK_RETURN(status)
+    MVGMayaUtil::setStringAttribute(_dagpath.node(), _MVG_IMAGE_SOURCE_PATH, originalImagePath);
+
+    // File name without directory nor extension
+    std::string fileName(originalImagePath.asChar());
+    const size_t separatorIndex = fileName.find_last_of("/\\");
+    if(separatorIndex != std::string::npos)
+        fileName = fileName.substr(separatorIndex + 1);
+    const size_t extensionIndex = fileName.find_last_of('.');
+    if(extensionIndex != std::string::npos && extensionIndex > 0)
+        fileName = fileName.substr(0, extensionIndex);
+
+    std::stringstream imageName;
+    imageName << fileName << "-" << getId();
+    const std::string imagePath =
+        projectDirectory + "/undistort/proxy/" + imageName.str() + "-UOP.jpg";
+    const std::string thumbnailPath =
+        projectDirectory + "/undistort/thumbnail/" + imageName.str() + "-UOT.jpg";
+    MVGMayaUtil::setStringAttribute(_dagpath.node(), _MVG_IMAGE_PATH, imagePath.c_str());
+    MVGMayaUtil::setStringAttribute(_dagpath.node(), _MVG_THUMBNAIL_PATH, thumbnailPath.c_str());
 }
 
 MDagPath MVGCamera::getImagePlaneShapeDagPath() const
@@ -246,6 +304,26 @@ void MVGCamera::setImagePlane() const
     fnImage.findPlug("depth").setValue(camera.farClippingPlane() * 0.9);
 }
 
+/**
+ * Set the image plane file to the proxy image (mvg_imagePath), if not already set.
+ */
+void MVGCamera::loadImagePlane() const
+{
+    MStatus status;
+    MFnDagNode fnImage(getImagePlaneShapeDagPath(), &status);
+    CHECK_RETURN(status)
+    MPlug imageNamePlug = fnImage.findPlug("imageName", &status);
+    CHECK_RETURN(status)
+    MFnDagNode fnCamera(_dagpath, &status);
+    CHECK_RETURN(status)
+    const MString imagePath = fnCamera.findPlug(_MVG_IMAGE_PATH, &status).asString();
+    CHECK_RETURN(status)
+    if(imageNamePlug.asString() == imagePath)
+        return;
+    status = imageNamePlug.setValue(imagePath);
+    CHECK_RETURN(status)
+}
+
 void MVGCamera::unloadImagePlane() const
 {
     MStatus status;
@@ -275,19 +353,19 @@ void MVGCamera::getSensorSize(MIntArray& sensorSize) const
     CHECK(status)
 }
 
-void MVGCamera::getVisibleIndexes(MIntArray& visibleIndexes) const
+void MVGCamera::getIntrinsicParams(MDoubleArray& intrinsicParams) const
 {
     MStatus status;
-    status = MVGMayaUtil::getIntArrayAttribute(_dagpath.node(), _MVG_ITEMS, visibleIndexes);
+    status = MVGMayaUtil::getDoubleArrayAttribute(_dagpath.node(), _MVG_INTRINSICS_PARAMS,
+                                                  intrinsicParams);
     CHECK(status)
 }
 
-void MVGCamera::getVisibleItems(std::vector<MVGPointCloudItem>& visibleItems) const
+void MVGCamera::getVisibleIndexes(MIntArray& visibleIndexes) const
 {
-    MIntArray visibleIndexes;
-    getVisibleIndexes(visibleIndexes);
-    MVGPointCloud pointCloud(MVGProject::_CLOUD);
-    pointCloud.getItems(visibleItems, visibleIndexes);
+    MStatus status;
+    status = MVGMayaUtil::getIntArrayAttribute(_dagpath.node(), _MVG_ITEMS, visibleIndexes);
+    CHECK(status)
 }
 
 void MVGCamera::setVisibleItems(const std::vector<MVGPointCloudItem>& items) const
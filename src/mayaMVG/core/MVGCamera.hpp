@@ -8,11 +8,14 @@
 class MString;
 class MPoint;
 class MIntArray;
+class MDoubleArray;
+class MDagPathArray;
 
 namespace mayaMVG
 {
 
 class MVGPointCloudItem;
+class MVGVisibilityIndex;
 
 class MVGCamera : public MVGNodeWrapper
 {
@@ -31,7 +34,9 @@ public:
     virtual bool isValid() const;
 
 public:
-    static MVGCamera create(MDagPath& cameraDagPath, std::map<int, MIntArray>& itemsPerCamera);
+    static MVGCamera create(MDagPath& cameraDagPath, const MVGVisibilityIndex& visibility);
+    static std::vector<MVGCamera> create(const MDagPathArray& cameraDagPaths,
+                                         const MVGVisibilityIndex& visibility);
     static std::vector<MVGCamera> getCameras();
 
 public:
@@ -39,12 +44,14 @@ public:
     void setId(const int&) const;
     MDagPath getImagePlaneShapeDagPath() const;
     std::string getThumbnailPath() const;
+    void setImagesPaths(const std::string& projectDirectory) const;
     void setImagePlane() const;
+    void loadImagePlane() const;
     void unloadImagePlane() const;
     MPoint getCenter(MSpace::Space space = MSpace::kWorld) const;
     void getSensorSize(MIntArray& sensorSize) const;
+    void getIntrinsicParams(MDoubleArray& intrinsicParams) const;
     void getVisibleIndexes(MIntArray& visibleIndexes) const;
-    void getVisibleItems(std::vector<MVGPointCloudItem>& visibleItems) const;
     void setVisibleItems(const std::vector<MVGPointCloudItem>& item) const;
     double getZoom() const;
     void setZoom(const double zoom) const;
@@ -0,0 +1,181 @@
+#include "mayaMVG/core/MVGCameraRegistry.hpp"
+#include "mayaMVG/core/MVGCamera.hpp"
+#include "mayaMVG/core/MVGGeometryUtil.hpp"
+#include "mayaMVG/core/MVGLog.hpp"
+#include <maya/MItDependencyNodes.h>
+#include <maya/MTransformationMatrix.h>
+#include <maya/MDoubleArray.h>
+#include <maya/MIntArray.h>
+
+namespace mayaMVG
+{
+
+MVGCameraRegistry::CameraDataMap MVGCameraRegistry::_cameras;
+MCallbackIdArray MVGCameraRegistry::_callbacks;
+bool MVGCameraRegistry::_isValid = false;
+MVGCameraIndex MVGCameraRegistry::_cameraIndex;
+bool MVGCameraRegistry::_isIndexValid = false;
+
+/**
+ * @param[in] viewId
+ * @return cached data of the camera, or NULL if no camera has this view id.
+ * The returned pointer is valid until the next invalidation.
+ */
+const MVGCameraRegistry::CameraData* MVGCameraRegistry::getCameraData(const int viewId)
+{
+    if(!_isValid)
+        rebuild();
+    // Views without camera in the scene are frequent : unknown ids must not rescan the scene
+    CameraDataMap::iterator it = _cameras.find(viewId);
+    if(it == _cameras.end() || !it->second.dagPath.isValid())
+        return NULL;
+    if(it->second.isDirty)
+        updateMatrices(it->second);
+    return &it->second;
+}
+
+bool MVGCameraRegistry::getDagPath(const int viewId, MDagPath& dagPath)
+{
+    const CameraData* cameraData = getCameraData(viewId);
+    if(!cameraData)
+        return false;
+    dagPath = cameraData->dagPath;
+    return true;
+}
+
+/**
+ * @return the spatial index of all cameras, identified by view id.
+ * The returned reference is valid until the next invalidation or camera move.
+ */
+const MVGCameraIndex& MVGCameraRegistry::getCameraIndex()
+{
+    if(!_isValid)
+        rebuild();
+    if(_isIndexValid)
+        return _cameraIndex;
+
+    std::vector<int> ids;
+    ids.reserve(_cameras.size());
+    aliceVision::Mat3X centers(3, _cameras.size());
+    aliceVision::Mat3X directions(3, _cameras.size());
+    for(CameraDataMap::iterator it = _cameras.begin(); it != _cameras.end(); ++it)
+    {
+        if(!it->second.dagPath.isValid())
+            continue;
+        if(it->second.isDirty)
+            updateMatrices(it->second);
+        const int col = static_cast<int>(ids.size());
+        centers.col(col) = TO_VEC3(it->second.center);
+        directions.col(col) = TO_VEC3(it->second.viewDirection);
+        ids.push_back(it->first);
+    }
+    const int count = static_cast<int>(ids.size());
+    _cameraIndex.build(ids, centers.leftCols(count), directions.leftCols(count));
+    _isIndexValid = true;
+    return _cameraIndex;
+}
+
+void MVGCameraRegistry::invalidate()
+{
+    if(_callbacks.length() > 0)
+        MMessage::removeCallbacks(_callbacks);
+    _callbacks.clear();
+    _cameras.clear();
+    _isValid = false;
+    _cameraIndex.clear();
+    _isIndexValid = false;
+}
+
+void MVGCameraRegistry::rebuild()
+{
+    invalidate();
+    MStatus status;
+    MDagPath path;
+    MItDependencyNodes it(MFn::kCamera);
+    for(; !it.isDone(); it.next())
+    {
+        // A camera without path is skipped, not to leave the registry half built
+        status = MDagPath::getAPathTo(it.thisNode(), path);
+        if(!status)
+            continue;
+        MVGCamera camera(path);
+        if(!camera.isValid())
+            continue;
+        CameraData& cameraData = _cameras[camera.getId()];
+        cameraData.dagPath = path;
+        MDoubleArray intrinsicParams;
+        camera.getIntrinsicParams(intrinsicParams);
+        if(intrinsicParams.length() > 0)
+            cameraData.focalLength = intrinsicParams[0];
+        MIntArray sensorSize;
+        camera.getSensorSize(sensorSize);
+        if(sensorSize.length() > 1)
+        {
+            cameraData.sensorWidth = sensorSize[0];
+            cameraData.sensorHeight = sensorSize[1];
+        }
+        cameraData.horizontalFilmAperture = camera.getHorizontalFilmAperture();
+        cameraData.isDirty = true;
+        // Map nodes are not moved, so the entry address can be given to the callback
+        MCallbackId id = MDagMessage::addWorldMatrixModifiedCallback(path, worldMatrixModifiedCB,
+                                                                     &cameraData, &status);
+        if(status)
+            _callbacks.append(id);
+    }
+    _isValid = true;
+}
+
+void MVGCameraRegistry::updateMatrices(CameraData& cameraData)
+{
+    MVGCamera camera(cameraData.dagPath);
+    cameraData.center = camera.getCenter();
+    cameraData.inclusiveMatrix = cameraData.dagPath.inclusiveMatrix();
+    // Maya cameras look down their local -Z axis
+    cameraData.viewDirection = -MVector(cameraData.inclusiveMatrix[2][0],
+                                        cameraData.inclusiveMatrix[2][1],
+                                        cameraData.inclusiveMatrix[2][2]);
+    cameraData.viewDirection.normalize();
+
+    // Keep ideal intrinsic matrix with principal point centered
+    //
+    // K Matrix:
+    // f*k_u     0      c_u
+    //   0     f*k_v    c_v
+    //   0       0       1
+    // c_u, c_v : the principal point, which would be ideally in the centre of the image.
+    //
+    aliceVision::Mat3 K;
+    K << cameraData.focalLength, 0.0, cameraData.sensorWidth / 2.0, 0.0, cameraData.focalLength,
+        cameraData.sensorHeight / 2.0, 0.0, 0.0, 1.0;
+
+    // Retrieve rotation from the transformation matrix
+    const MTransformationMatrix transformMatrix(cameraData.inclusiveMatrix);
+    aliceVision::Mat3 R;
+    MMatrix rotationMatrix = transformMatrix.asRotateMatrix();
+    for(int m = 0; m < 3; ++m)
+    {
+        for(int j = 0; j < 3; ++j)
+        {
+            // Maya has inverted Y and Z axes
+            int sign = 1;
+            if(m > 0)
+                sign = -1;
+            R(m, j) = sign * rotationMatrix[m][j];
+        }
+    }
+
+    MVGGeometry::computeProjectionMatrix(K, R, TO_VEC3(cameraData.center),
+                                         cameraData.projectionMatrix);
+    cameraData.isDirty = false;
+}
+
+void MVGCameraRegistry::worldMatrixModifiedCB(MObject& /*transformNode*/,
+                                              MDagMessage::MatrixModifiedFlags& /*modified*/,
+                                              void* cameraData)
+{
+    // Matrices are updated on the next request, don't query the DAG while it is being modified
+    static_cast<CameraData*>(cameraData)->isDirty = true;
+    _isIndexValid = false;
+}
+
+} // namespace
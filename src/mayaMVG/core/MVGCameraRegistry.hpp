@@ -0,0 +1,73 @@
+#pragma once
+
+#include "mayaMVG/core/MVGEigen.hpp"
+#include "mayaMVG/geometry/MVGCameraIndex.hpp"
+#include <maya/MDagPath.h>
+#include <maya/MMatrix.h>
+#include <maya/MPoint.h>
+#include <maya/MVector.h>
+#include <maya/MCallbackIdArray.h>
+#include <maya/MDagMessage.h>
+#include <map>
+
+namespace mayaMVG
+{
+
+/**
+ * Lookup table from view id (mvg_viewId attribute) to MayaMVG camera.
+ * Built on first request by scanning the scene cameras once, then invalidated when cameras are
+ * added or removed, or when the scene is transformed (see MVGMayaCallbacks.hpp).
+ * Camera matrices are updated on the next request when a camera world matrix changes.
+ * A spatial index over camera centres and viewing directions is built on demand, and rebuilt
+ * after any camera has moved.
+ */
+class MVGCameraRegistry
+{
+public:
+    struct CameraData
+    {
+        CameraData()
+            : focalLength(0.0)
+            , sensorWidth(0)
+            , sensorHeight(0)
+            , horizontalFilmAperture(0.0)
+            , isDirty(true)
+        {
+        }
+        MDagPath dagPath;
+        double focalLength; // in pixels (mvg_intrinsicParams[0])
+        int sensorWidth;    // in pixels
+        int sensorHeight;   // in pixels
+        double horizontalFilmAperture;
+        MPoint center;         // in world space
+        MVector viewDirection; // normalized, in world space
+        MMatrix inclusiveMatrix;
+        aliceVision::Mat34 projectionMatrix; // world space to image space (pixels)
+        bool isDirty;                        // matrices need to be updated
+    };
+    typedef std::map<int, CameraData, std::less<int>,
+                     Eigen::aligned_allocator<std::pair<const int, CameraData> > >
+        CameraDataMap;
+
+public:
+    static const CameraData* getCameraData(const int viewId);
+    static bool getDagPath(const int viewId, MDagPath& dagPath);
+    static const MVGCameraIndex& getCameraIndex();
+    static void invalidate();
+
+private:
+    static void rebuild();
+    static void updateMatrices(CameraData& cameraData);
+    static void worldMatrixModifiedCB(MObject& transformNode,
+                                      MDagMessage::MatrixModifiedFlags& modified,
+                                      void* cameraData);
+
+private:
+    static CameraDataMap _cameras;
+    static MCallbackIdArray _callbacks; // world matrix callbacks, one per camera
+    static bool _isValid;
+    static MVGCameraIndex _cameraIndex; // ids are view ids
+    static bool _isIndexValid;
+};
+
+} // namespace
@@ -2,13 +2,9 @@
 #include "mayaMVG/core/MVGPointCloud.hpp"
 #include "mayaMVG/core/MVGProject.hpp"
 #include "mayaMVG/core/MVGCamera.hpp"
+#include "mayaMVG/core/MVGCameraRegistry.hpp"
 #include "mayaMVG/core/MVGLog.hpp"
-#include "mayaMVG/core/MVGPlaneKernel.hpp"
-#include "mayaMVG/core/MVGLineConstrainedPlaneKernel.hpp"
 #include "mayaMVG/maya/MVGMayaUtil.hpp"
-#include <aliceVision/multiview/triangulation/Triangulation.hpp>
-#include <aliceVision/multiview/projection.hpp>
-#include <aliceVision/robustEstimation/leastMedianOfSquares.hpp>
 #include <maya/MPointArray.h>
 #include <maya/M3dView.h>
 #include <maya/MPlug.h>
@@ -125,9 +121,11 @@ MPoint MVGGeometryUtil::worldToViewSpace(M3dView& view, const MPoint& worldPoint
 void MVGGeometryUtil::worldToViewSpace(M3dView& view, const MPointArray& worldPoints,
                                        MPointArray& viewPoints)
 {
+    MVGViewProjection projection;
+    getViewProjection(view, projection);
     viewPoints.setLength(worldPoints.length());
     for(size_t i = 0; i < worldPoints.length(); ++i)
-        worldToViewSpace(view, worldPoints[i], viewPoints[i]);
+        worldToViewSpace(projection, worldPoints[i], viewPoints[i]);
 }
 
 MPointArray MVGGeometryUtil::worldToViewSpace(M3dView& view, const MPointArray& worldPoints)
@@ -183,18 +181,70 @@ MPoint MVGGeometryUtil::worldToCameraSpace(M3dView& view, const MPoint& worldPoi
 void MVGGeometryUtil::worldToCameraSpace(M3dView& view, const MPointArray& worldPoints,
                                          MPointArray& cameraPoints)
 {
+    MVGViewProjection projection;
+    getViewProjection(view, projection);
     cameraPoints.setLength(worldPoints.length());
     for(size_t i = 0; i < worldPoints.length(); ++i)
-        viewToCameraSpace(view, worldToViewSpace(view, worldPoints[i]), cameraPoints[i]);
+        worldToCameraSpace(projection, worldPoints[i], cameraPoints[i]);
 }
 
 MPointArray MVGGeometryUtil::worldToCameraSpace(M3dView& view, const MPointArray& worldPoints)
 {
     MPointArray points;
-    viewToCameraSpace(view, worldToViewSpace(view, worldPoints), points);
+    worldToCameraSpace(view, worldPoints, points);
     return points;
 }
 
+/**
+ * Capture the view and camera parameters needed by the batched space conversions.
+ *
+ * @param[in] view
+ * @param[out] projection
+ */
+void MVGGeometryUtil::getViewProjection(M3dView& view, MVGViewProjection& projection)
+{
+    MMatrix modelViewMatrix, projectionMatrix;
+    CHECK(view.modelViewMatrix(modelViewMatrix))
+    CHECK(view.projectionMatrix(projectionMatrix))
+    const MMatrix worldToClip = modelViewMatrix * projectionMatrix;
+    for(int i = 0; i < 4; ++i)
+        for(int j = 0; j < 4; ++j)
+            projection.worldToClip[i][j] = worldToClip(i, j);
+    unsigned int viewportX, viewportY, viewportWidth, viewportHeight;
+    view.viewport(viewportX, viewportY, viewportWidth, viewportHeight);
+    projection.viewportWidth = static_cast<double>(viewportWidth);
+    projection.viewportHeight = static_cast<double>(viewportHeight);
+    projection.portWidth = static_cast<double>(view.portWidth());
+    projection.portHeight = static_cast<double>(view.portHeight());
+    MDagPath dagPath;
+    view.getCamera(dagPath);
+    MVGCamera camera(dagPath);
+    projection.filmScale = camera.getHorizontalFilmAperture() * camera.getZoom();
+    projection.horizontalPan = camera.getHorizontalPan();
+    projection.verticalPan = camera.getVerticalPan();
+}
+
+void MVGGeometryUtil::worldToViewSpace(const MVGViewProjection& projection,
+                                       const MPoint& worldPoint, MPoint& viewPoint)
+{
+    aliceVision::Vec2 point;
+    MVGGeometry::worldToViewSpace(projection, TO_VEC3(worldPoint), point);
+    viewPoint.x = point(0);
+    viewPoint.y = point(1);
+    viewPoint.z = 0.0;
+}
+
+void MVGGeometryUtil::worldToCameraSpace(const MVGViewProjection& projection,
+                                         const MPoint& worldPoint, MPoint& cameraPoint)
+{
+    aliceVision::Vec2 point;
+    MVGGeometry::worldToViewSpace(projection, TO_VEC3(worldPoint), point);
+    MVGGeometry::viewToCameraSpace(projection, point, point);
+    cameraPoint.x = point(0);
+    cameraPoint.y = point(1);
+    cameraPoint.z = 0.0;
+}
+
 void MVGGeometryUtil::cameraToWorldSpace(M3dView& view, const MPoint& cameraPoint,
                                          MPoint& worldPoint)
 {
@@ -226,17 +276,14 @@ MPointArray MVGGeometryUtil::cameraToWorldSpace(M3dView& view, const MPointArray
 void MVGGeometryUtil::cameraToImageSpace(MVGCamera& camera, const MPoint& cameraPoint,
                                          MPoint& imagePoint)
 {
-    MFnDagNode fnImage(camera.getImagePlaneShapeDagPath());
-
     MIntArray sensorSize;
     camera.getSensorSize(sensorSize);
-    const double width = sensorSize[0];
-    const double height = sensorSize[1];
-    assert(camera.getHorizontalFilmAperture() != 0.0);
-    MPoint pointCenteredNorm = cameraPoint / camera.getHorizontalFilmAperture();
-    const double verticalMargin = (width - height) / 2.0;
-    imagePoint.x = (pointCenteredNorm.x + 0.5) * width;
-    imagePoint.y = (-pointCenteredNorm.y + 0.5) * width - verticalMargin;
+    aliceVision::Vec2 point;
+    MVGGeometry::cameraToImageSpace(camera.getHorizontalFilmAperture(), sensorSize[0],
+                                    sensorSize[1], aliceVision::Vec2(cameraPoint.x, cameraPoint.y),
+                                    point);
+    imagePoint.x = point(0);
+    imagePoint.y = point(1);
 }
 
 MPoint MVGGeometryUtil::cameraToImageSpace(MVGCamera& camera, const MPoint& cameraPoint)
@@ -265,9 +312,11 @@ MPointArray MVGGeometryUtil::cameraToImageSpace(MVGCamera& camera, const MPointA
  *
  * @param[in] pointsWS : all points used to compute plane in World Space coordinates
  * @param[out] model : computed plane
+ * @param[in] options : robust estimation method and parameters
  * @return
  */
-bool MVGGeometryUtil::computePlane(const MPointArray& pointsWS, PlaneKernel::Model& model)
+bool MVGGeometryUtil::computePlane(const MPointArray& pointsWS, PlaneKernel::Model& model,
+                                   const MVGPlaneEstimatorOptions& options)
 {
     if(pointsWS.length() < 3)
         return false;
@@ -275,11 +324,7 @@ bool MVGGeometryUtil::computePlane(const MPointArray& pointsWS, PlaneKernel::Mod
     aliceVision::Mat facePointsMat(3, pointsWS.length());
     for(size_t i = 0; i < pointsWS.length(); ++i)
         facePointsMat.col(i) = TO_VEC3(pointsWS[i]);
-    PlaneKernel kernel(facePointsMat);
-    double outlierThreshold = std::numeric_limits<double>::infinity();
-    aliceVision::robustEstimation::LeastMedianOfSquares(kernel, &model, &outlierThreshold);
-
-    return true;
+    return MVGGeometry::computePlane(facePointsMat, model, options);
 }
 
 /**
@@ -287,11 +332,13 @@ bool MVGGeometryUtil::computePlane(const MPointArray& pointsWS, PlaneKernel::Mod
  * @param[in] pointsWS: all points used to compute plane in World Space coordinates
  * @param[in] constraintPoints : points describing the line constraint
  * @param[out] model : computed plane
+ * @param[in] options : robust estimation method and parameters
  * @return
  */
 bool MVGGeometryUtil::computePlaneWithLineConstraint(const MPointArray& pointsWS,
                                                      const MPointArray& constraintPoints,
-                                                     LineConstrainedPlaneKernel::Model& model)
+                                                     LineConstrainedPlaneKernel::Model& model,
+                                                     const MVGPlaneEstimatorOptions& options)
 {
     if(pointsWS.length() < 3)
         return false;
@@ -300,12 +347,8 @@ bool MVGGeometryUtil::computePlaneWithLineConstraint(const MPointArray& pointsWS
     aliceVision::Mat facePointsMat(3, pointsWS.length());
     for(size_t i = 0; i < pointsWS.length(); ++i)
         facePointsMat.col(i) = TO_VEC3(pointsWS[i]);
-    LineConstrainedPlaneKernel kernel(facePointsMat, TO_VEC3(constraintPoints[0]),
-                                      TO_VEC3(constraintPoints[1]));
-    double outlierThreshold = std::numeric_limits<double>::infinity();
-    aliceVision::robustEstimation::LeastMedianOfSquares(kernel, &model, &outlierThreshold);
-
-    return true;
+    return MVGGeometry::computePlaneWithLineConstraint(
+        facePointsMat, TO_VEC3(constraintPoints[0]), TO_VEC3(constraintPoints[1]), model, options);
 }
 
 /**
@@ -325,16 +368,17 @@ bool MVGGeometryUtil::projectPointsOnPlane(M3dView& view, const MPointArray& toP
     MDagPath cameraPath;
     view.getCamera(cameraPath);
     MVGCamera camera(cameraPath);
-    MPoint cameraCenter = camera.getCenter();
+    const aliceVision::Vec3 cameraCenter = TO_VEC3(camera.getCenter());
 
     // project points on computed plane
-    MPoint projectedWSPoint;
+    aliceVision::Vec3 projectedWSPoint;
     for(size_t i = 0; i < toProjectCSPoints.length(); ++i)
     {
-        plane_line_intersect(planeModel, cameraCenter,
-                             MVGGeometryUtil::cameraToWorldSpace(view, toProjectCSPoints[i]),
+        const MPoint toProjectWSPoint =
+            MVGGeometryUtil::cameraToWorldSpace(view, toProjectCSPoints[i]);
+        plane_line_intersect(planeModel, cameraCenter, TO_VEC3(toProjectWSPoint),
                              projectedWSPoint);
-        projectedWSPoints.append(projectedWSPoint);
+        projectedWSPoints.append(TO_MPOINT(projectedWSPoint));
     }
     assert(toProjectCSPoints.length() == projectedWSPoints.length());
     return true;
@@ -371,77 +415,39 @@ void MVGGeometryUtil::triangulatePoint(const std::map<int, MPoint>& point2dPerCa
     aliceVision::Mat2X imagePoints(2, cameraCount);
 
     std::vector<aliceVision::Mat34> projectiveCameras;
+    projectiveCameras.reserve(cameraCount);
     {
         std::map<int, MPoint>::const_iterator it = point2dPerCamera_CS.begin();
         for(size_t i = 0; it != point2dPerCamera_CS.end(); ++i, ++it)
         {
-            MVGCamera camera(it->first);
-            const MPoint& point2d_CS = it->second;
-
-            // Retrieve the intrinsic matrix from 'pinholeProjectionMatrix' attribute
-            //
-            // K Matrix:
-            // f*k_u     0      c_u
-            //   0     f*k_v    c_v
-            //   0       0       1
-            // c_u, c_v : the principal point, which would be ideally in the centre of the image.
-            //
-            MDoubleArray intrinsicsArray;
-            MVGMayaUtil::getDoubleArrayAttribute(camera.getDagPath().node(), "mvg_intrinsicParams",
-                                                 intrinsicsArray);
-            MIntArray sensorSize;
-            camera.getSensorSize(sensorSize);
-
-            // Keep ideal matrix with principal point centered
-            aliceVision::Mat3 K;
-            K << intrinsicsArray[0], 0.0, sensorSize[0] / 2.0, 0.0, intrinsicsArray[0],
-                sensorSize[1] / 2.0, 0.0, 0.0, 1.0;
-
-            // Retrieve transformation matrix
-            const MMatrix inclusiveMatrix = camera.getDagPath().inclusiveMatrix();
-            const MTransformationMatrix transformMatrix(inclusiveMatrix);
-            aliceVision::Mat3 R;
-            MMatrix rotationMatrix = transformMatrix.asRotateMatrix();
-            for(int m = 0; m < 3; ++m)
+            const MVGCameraRegistry::CameraData* cameraData =
+                MVGCameraRegistry::getCameraData(it->first);
+            if(!cameraData)
             {
-                for(int j = 0; j < 3; ++j)
-                {
-                    // Maya has inverted Y and Z axes
-                    int sign = 1;
-                    if(m > 0)
-                        sign = -1;
-                    R(m, j) = sign * rotationMatrix[m][j];
-                }
+                LOG_ERROR("Unable to find camera with id " << it->first)
+                return;
             }
+            const MPoint& point2d_CS = it->second;
 
-            // Retrieve translation vector
-            const aliceVision::Vec3 C = TO_VEC3(camera.getCenter());
-            const aliceVision::Vec3 t = -R * C;
-
-            // Compute projection matrix
-            aliceVision::Mat34 P;
-            aliceVision::P_From_KRt(K, R, t, &P);
-            projectiveCameras.push_back(P);
+            // Cached projection matrix
+            projectiveCameras.push_back(cameraData->projectionMatrix);
 
             // clicked point matrix (image space)
-            MPoint clickedISPosition;
-            MVGGeometryUtil::cameraToImageSpace(camera, point2d_CS, clickedISPosition);
-            imagePoints.col(i) = aliceVision::Vec2(clickedISPosition.x, clickedISPosition.y);
+            aliceVision::Vec2 clickedISPosition;
+            MVGGeometry::cameraToImageSpace(
+                cameraData->horizontalFilmAperture, cameraData->sensorWidth,
+                cameraData->sensorHeight, aliceVision::Vec2(point2d_CS.x, point2d_CS.y),
+                clickedISPosition);
+            imagePoints.col(i) = clickedISPosition;
         }
     }
 
     // call n-view triangulation function
-    aliceVision::Vec4 result;
-    aliceVision::TriangulateNViewAlgebraic(imagePoints, projectiveCameras, &result);
-    outTriangulatedPoint_WS.x = result(0);
-    outTriangulatedPoint_WS.y = result(1);
-    outTriangulatedPoint_WS.z = result(2);
-    if(result(3) == 0.0)
-    {
+    aliceVision::Vec3 result;
+    const bool success = MVGGeometry::triangulatePoint(imagePoints, projectiveCameras, result);
+    outTriangulatedPoint_WS = TO_MPOINT(result);
+    if(!success)
         LOG_ERROR("Triangulated point w = 0")
-        return;
-    }
-    outTriangulatedPoint_WS = outTriangulatedPoint_WS / result(3);
 }
 
 double MVGGeometryUtil::crossProduct2D(MVector& A, MVector& B)
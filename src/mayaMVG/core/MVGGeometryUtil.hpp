@@ -1,11 +1,11 @@
 #pragma once
 
-#include "mayaMVG/core/MVGPlaneKernel.hpp"
-#include "mayaMVG/core/MVGLineConstrainedPlaneKernel.hpp"
+#include "mayaMVG/geometry/MVGGeometry.hpp"
 
 #include <maya/MVector.h>
 
 #include <map>
+#include <vector>
 
 
 class MPoint;
@@ -53,6 +53,13 @@ struct MVGGeometryUtil
                                    MPointArray& cameraPoints);
     static MPointArray worldToCameraSpace(M3dView& view, const MPointArray& worldPoints);
 
+    // batched space conversion
+    static void getViewProjection(M3dView& view, MVGViewProjection& projection);
+    static void worldToViewSpace(const MVGViewProjection& projection, const MPoint& worldPoint,
+                                 MPoint& viewPoint);
+    static void worldToCameraSpace(const MVGViewProjection& projection, const MPoint& worldPoint,
+                                   MPoint& cameraPoint);
+
     static void cameraToWorldSpace(M3dView& view, const MPoint& cameraPoint, MPoint& worldPoint);
     static MPoint cameraToWorldSpace(M3dView& view, const MPoint& cameraPoint);
     static void cameraToWorldSpace(M3dView& view, const MPointArray& cameraPoints,
@@ -67,10 +74,13 @@ struct MVGGeometryUtil
     static MPointArray cameraToImageSpace(MVGCamera& camera, const MPointArray& cameraPoint);
 
     // projections
-    static bool computePlane(const MPointArray& points, PlaneKernel::Model& model);
+    static bool computePlane(const MPointArray& points, PlaneKernel::Model& model,
+                             const MVGPlaneEstimatorOptions& options = MVGPlaneEstimatorOptions());
     static bool computePlaneWithLineConstraint(const MPointArray& pointsWS,
                                                const MPointArray& constraintPoints,
-                                               LineConstrainedPlaneKernel::Model& model);
+                                               LineConstrainedPlaneKernel::Model& model,
+                                               const MVGPlaneEstimatorOptions& options =
+                                                   MVGPlaneEstimatorOptions());
     static bool projectPointsOnPlane(M3dView& view, const MPointArray& toProjectCSPoints,
                                      const PlaneKernel::Model& planeModel,
                                      MPointArray& projectedWSPoints);
@@ -16,6 +16,9 @@
 #include <maya/MPointArray.h>
 #include <maya/MFloatPointArray.h>
 #include <maya/MFnNumericAttribute.h>
+#include <maya/MFnTypedAttribute.h>
+#include <maya/MFnDoubleArrayData.h>
+#include <maya/MDGModifier.h>
 #include <maya/MPlug.h>
 #include <maya/MArgList.h>
 #include <cassert>
@@ -39,6 +42,7 @@ void binaryToVectorData(const char* binaryData, const int binarySize,
 
 int MVGMesh::_blindDataID = 0; // FIXME
 MString MVGMesh::_MVG = "mvg";
+MString MVGMesh::_MVG_OBSERVATIONS = "mvgObservations";
 
 MVGMesh::MVGMesh(const std::string& dagPathAsString)
     : MVGNodeWrapper(dagPathAsString)
@@ -336,17 +340,34 @@ MStatus MVGMesh::setPoint(const int vertexId, const MPoint& point) const
     return status;
 }
 
+/**
+ * Move several vertices with a single read and a single write of the mesh points.
+ * Mesh data (as edited by MVGMeshEditNode) has no dag path: positions are then in object space.
+ */
 MStatus MVGMesh::setPoints(const MIntArray& verticesIds, const MPointArray& points) const
 {
     MStatus status;
     assert(verticesIds.length() == points.length());
-    assert(_dagpath.isValid());
-    MFnMesh fnMesh(_dagpath, &status);
-    for(int i = 0; i < verticesIds.length(); ++i)
+    if(verticesIds.length() == 0)
+        return status;
+    MFnMesh fnMesh;
+    if(_dagpath.isValid())
+        status = fnMesh.setObject(_dagpath);
+    else
+        status = fnMesh.setObject(_object);
+    CHECK_RETURN_STATUS(status)
+    const MSpace::Space space = _dagpath.isValid() ? MSpace::kWorld : MSpace::kObject;
+    MPointArray meshPoints;
+    status = fnMesh.getPoints(meshPoints, space);
+    CHECK_RETURN_STATUS(status)
+    for(unsigned int i = 0; i < verticesIds.length(); ++i)
     {
-        status = fnMesh.setPoint(verticesIds[i], points[i], MSpace::kWorld);
-        CHECK_RETURN_STATUS(status);
+        if(verticesIds[i] < 0 || verticesIds[i] >= static_cast<int>(meshPoints.length()))
+            return MS::kFailure;
+        meshPoints[verticesIds[i]] = points[i];
     }
+    status = fnMesh.setPoints(meshPoints, space);
+    CHECK_RETURN_STATUS(status)
     fnMesh.syncObject();
     return status;
 }
@@ -361,52 +382,66 @@ MStatus MVGMesh::getPoint(int vertexId, MPoint& point) const
     return status;
 }
 
-MStatus MVGMesh::setBlindData(const int vertexId,
-                              std::vector<ClickedCSPosition>& clickedCSPositions) const
-{
-    MStatus status;
-    MFnMesh fnMesh(_object, &status);
-    CHECK_RETURN_STATUS(status);
-    char* charData = reinterpret_cast<char*>(clickedCSPositions.data());
-    const int binarySize = clickedCSPositions.size() * sizeof(ClickedCSPosition);
-    CHECK_RETURN_STATUS(
-        fnMesh.setIntBlindData(vertexId, MFn::kMeshVertComponent, _blindDataID, "size", binarySize))
-    CHECK_RETURN_STATUS(fnMesh.setBinaryBlindData(vertexId, MFn::kMeshVertComponent, _blindDataID,
-                                                  "data", charData, binarySize))
-    return status;
-}
-
-MStatus MVGMesh::getBlindData(const int vertexId,
-                              std::vector<ClickedCSPosition>& clickedCSPositions) const
+/**
+ * Read all the 2D observations of the mesh.
+ * Scenes saved with per-vertex blind data are read as is, until the next edit writes the packed
+ * attribute (see MVGEditCmd::editBlindData).
+ * Observations are indexed by vertex id : they are not remapped when vertices are renumbered by
+ * a topology edit made outside of MayaMVG.
+ */
+MStatus MVGMesh::getBlindData(MVGObservationTable& observations) const
 {
     MStatus status;
-    MFnMesh fnMesh(_object, &status);
-    CHECK_RETURN_STATUS(status);
-    if(!fnMesh.hasBlindData(MFn::kMeshVertComponent))
-        return MS::kFailure;
-    if(!fnMesh.hasBlindDataComponentId(vertexId, MFn::kMeshVertComponent, _blindDataID))
-        return MS::kFailure;
-    int binarySize;
-    CHECK_RETURN_STATUS(
-        fnMesh.getIntBlindData(vertexId, MFn::kMeshVertComponent, _blindDataID, "size", binarySize))
-    MString stringData;
-    CHECK_RETURN_STATUS(fnMesh.getBinaryBlindData(vertexId, MFn::kMeshVertComponent, _blindDataID,
-                                                  "data", stringData))
-    const char* binData = stringData.asChar(binarySize);
-    binaryToVectorData(binData, binarySize, clickedCSPositions);
+    observations.clear();
+    MFnDependencyNode fn(_object, &status);
+    CHECK_RETURN_STATUS(status)
+    MPlug plug = fn.findPlug(_MVG_OBSERVATIONS, false, &status);
+    if(!status)
+    {
+        getLegacyBlindData(observations);
+        return MS::kSuccess;
+    }
+    MObject data;
+    status = plug.getValue(data);
+    if(!status || data.isNull())
+        return MS::kSuccess;
+    MFnDoubleArrayData fnData(data, &status);
+    CHECK_RETURN_STATUS(status)
+    const MDoubleArray array = fnData.array();
+    std::vector<double> packed(array.length());
+    if(!packed.empty())
+        array.get(&packed[0]);
+    observations.unpack(packed.data(), static_cast<int>(packed.size()));
     return status;
 }
 
-MStatus MVGMesh::getBlindData(const int vertexId,
-                              std::map<int, MPoint>& cameraToClickedCSPoints) const
+/**
+ * Replace all the 2D observations of the mesh.
+ *
+ * @param[in] observations
+ * @param[in] modifier : if not NULL, the attribute is added and its value set by the modifier
+ * (see MDGModifier::doIt)
+ */
+MStatus MVGMesh::setBlindData(const MVGObservationTable& observations,
+                              MDGModifier* modifier) const
 {
     MStatus status;
-    std::vector<ClickedCSPosition> data;
-    if(!getBlindData(vertexId, data))
-        return MS::kFailure;
-    std::vector<ClickedCSPosition>::const_iterator it = data.begin();
-    for(; it != data.end(); ++it)
-        cameraToClickedCSPoints[it->cameraId] = MPoint(it->x, it->y);
+    CHECK_RETURN_STATUS(ensureBlindDataAttribute(modifier))
+    MFnDependencyNode fn(_object, &status);
+    CHECK_RETURN_STATUS(status)
+    MPlug plug = fn.findPlug(_MVG_OBSERVATIONS, false, &status);
+    CHECK_RETURN_STATUS(status)
+    std::vector<double> packed;
+    observations.pack(packed);
+    const MDoubleArray array(packed.data(), static_cast<unsigned int>(packed.size()));
+    MFnDoubleArrayData fnData;
+    MObject data = fnData.create(array, &status);
+    CHECK_RETURN_STATUS(status)
+    if(modifier)
+        status = modifier->newPlugValue(plug, data);
+    else
+        status = plug.setValue(data);
+    CHECK_RETURN_STATUS(status)
     return status;
 }
 
@@ -437,41 +472,16 @@ MStatus MVGMesh::unsetAllBlindData() const
 
     return status;
 }
-MStatus MVGMesh::unsetBlindData(const int vertexId) const
-{
-    MStatus status;
-    // TODO : use clearBlindData function in MFnMesh
-    std::vector<ClickedCSPosition> vector;
-    status = setBlindData(vertexId, vector);
-    CHECK(status)
-    return status;
-}
-
-MStatus MVGMesh::getBlindDataPerCamera(const int vertexId, const int cameraId,
-                                       MPoint& point2D) const
-{
-    MStatus status;
-    std::vector<ClickedCSPosition> data;
-    status = getBlindData(vertexId, data);
-    CHECK_RETURN_STATUS(status)
-    for(std::vector<ClickedCSPosition>::iterator it = data.begin(); it != data.end(); ++it)
-    {
-        if(it->cameraId == cameraId)
-        {
-            point2D.x = it->x;
-            point2D.y = it->y;
-            return MS::kSuccess;
-        }
-    }
-    return MS::kFailure;
-}
 
-MStatus MVGMesh::setBlindDataPerCamera(const int vertexId, const int cameraId,
-                                       const MPoint& point2D) const
+/**
+ * Only used by the edit nodes of previous versions, replayed when evaluating their history.
+ */
+MStatus MVGMesh::setLegacyBlindDataPerCamera(const int vertexId, const int cameraId,
+                                             const MPoint& point2D) const
 {
     MStatus status;
     std::vector<ClickedCSPosition> data;
-    if(getBlindData(vertexId, data))
+    if(getLegacyBlindData(vertexId, data))
     {
         for(std::vector<ClickedCSPosition>::iterator it = data.begin(); it != data.end(); ++it)
         {
@@ -479,7 +489,7 @@ MStatus MVGMesh::setBlindDataPerCamera(const int vertexId, const int cameraId,
             {
                 it->x = point2D.x;
                 it->y = point2D.y;
-                status = setBlindData(vertexId, data);
+                status = setLegacyBlindData(vertexId, data);
                 CHECK(status)
                 return status;
             }
@@ -490,23 +500,114 @@ MStatus MVGMesh::setBlindDataPerCamera(const int vertexId, const int cameraId,
     newData.x = point2D.x;
     newData.y = point2D.y;
     data.push_back(newData);
-    status = setBlindData(vertexId, data);
+    status = setLegacyBlindData(vertexId, data);
     CHECK(status)
     return status;
 }
 
-MStatus MVGMesh::unsetBlindDataPerCamera(const int vertexId, const int cameraId) const
+MStatus MVGMesh::unsetLegacyBlindData(const int vertexId) const
 {
     MStatus status;
-    std::vector<ClickedCSPosition> data;
-    status = getBlindData(vertexId, data);
-    for(std::vector<ClickedCSPosition>::iterator it = data.begin(); it != data.end(); ++it)
+    std::vector<ClickedCSPosition> vector;
+    status = setLegacyBlindData(vertexId, vector);
+    CHECK(status)
+    return status;
+}
+
+MStatus MVGMesh::ensureBlindDataAttribute(MDGModifier* modifier) const
+{
+    MStatus status;
+    MFnDependencyNode fn(_object, &status);
+    CHECK_RETURN_STATUS(status)
+    if(!fn.hasAttribute(_MVG_OBSERVATIONS))
     {
-        if(it->cameraId == cameraId)
-            data.erase(it);
+        MFnTypedAttribute typedAttr;
+        MObject attrObject =
+            typedAttr.create(_MVG_OBSERVATIONS, "mvgo", MFnData::kDoubleArray, &status);
+        CHECK_RETURN_STATUS(status)
+        if(modifier)
+        {
+            // The plug is needed right away : execute the attribute creation only
+            CHECK_RETURN_STATUS(modifier->addAttribute(_object, attrObject))
+            status = modifier->doIt();
+        }
+        else
+            status = fn.addAttribute(attrObject);
+        CHECK_RETURN_STATUS(status)
     }
-    status = setBlindData(vertexId, data);
-    CHECK(status)
+    return status;
+}
+
+/**
+ * Read the per-vertex blind data written by previous versions: an int size and a binary blob of
+ * ClickedCSPosition per vertex.
+ */
+MStatus MVGMesh::getLegacyBlindData(MVGObservationTable& observations) const
+{
+    MStatus status;
+    MFnMesh fnMesh(_object, &status);
+    CHECK_RETURN_STATUS(status);
+    if(!fnMesh.hasBlindData(MFn::kMeshVertComponent))
+        return MS::kFailure;
+    MIntArray vertexIds;
+    MStringArray binaryData;
+    status = fnMesh.getBinaryBlindData(MFn::kMeshVertComponent, _blindDataID, "data", vertexIds,
+                                       binaryData);
+    CHECK_RETURN_STATUS(status)
+    std::vector<MVGObservationTable::Observation> legacyObservations;
+    std::vector<ClickedCSPosition> clickedCSPositions;
+    for(unsigned int i = 0; i < vertexIds.length(); ++i)
+    {
+        int binarySize = 0;
+        const char* binary = binaryData[i].asChar(binarySize);
+        binaryToVectorData(binary, binarySize, clickedCSPositions);
+        for(size_t j = 0; j < clickedCSPositions.size(); ++j)
+        {
+            MVGObservationTable::Observation observation;
+            observation.vertexId = vertexIds[i];
+            observation.cameraId = clickedCSPositions[j].cameraId;
+            observation.x = clickedCSPositions[j].x;
+            observation.y = clickedCSPositions[j].y;
+            legacyObservations.push_back(observation);
+        }
+    }
+    observations.setObservations(legacyObservations);
+    return status;
+}
+
+MStatus MVGMesh::getLegacyBlindData(const int vertexId,
+                                    std::vector<ClickedCSPosition>& clickedCSPositions) const
+{
+    MStatus status;
+    MFnMesh fnMesh(_object, &status);
+    CHECK_RETURN_STATUS(status);
+    if(!fnMesh.hasBlindData(MFn::kMeshVertComponent))
+        return MS::kFailure;
+    if(!fnMesh.hasBlindDataComponentId(vertexId, MFn::kMeshVertComponent, _blindDataID))
+        return MS::kFailure;
+    int binarySize;
+    CHECK_RETURN_STATUS(
+        fnMesh.getIntBlindData(vertexId, MFn::kMeshVertComponent, _blindDataID, "size", binarySize))
+    MString stringData;
+    CHECK_RETURN_STATUS(fnMesh.getBinaryBlindData(vertexId, MFn::kMeshVertComponent, _blindDataID,
+                                                  "data", stringData))
+    const char* binData = stringData.asChar(binarySize);
+    binaryToVectorData(binData, binarySize, clickedCSPositions);
+    return status;
+}
+
+MStatus MVGMesh::setLegacyBlindData(const int vertexId,
+                                    std::vector<ClickedCSPosition>& clickedCSPositions) const
+{
+    MStatus status;
+    MFnMesh fnMesh(_object, &status);
+    CHECK_RETURN_STATUS(status);
+    char* charData = reinterpret_cast<char*>(clickedCSPositions.data());
+    const int binarySize = clickedCSPositions.size() * sizeof(ClickedCSPosition);
+    CHECK_RETURN_STATUS(
+        fnMesh.setIntBlindData(vertexId, MFn::kMeshVertComponent, _blindDataID, "size", binarySize))
+    CHECK_RETURN_STATUS(fnMesh.setBinaryBlindData(vertexId, MFn::kMeshVertComponent, _blindDataID,
+                                                  "data", charData, binarySize))
     return status;
 }
 
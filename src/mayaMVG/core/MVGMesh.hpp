@@ -1,12 +1,14 @@
 #pragma once
 
 #include "mayaMVG/core/MVGNodeWrapper.hpp"
+#include "mayaMVG/geometry/MVGObservationTable.hpp"
 #include <vector>
 #include <map>
 
 class MPoint;
 class MPointArray;
 class MIntArray;
+class MDGModifier;
 
 namespace mayaMVG
 {
@@ -51,19 +53,26 @@ public:
     MStatus getPoint(const int vertexId, MPoint& point) const;
     MStatus setPoint(const int vertexId, const MPoint& point) const;
     MStatus setPoints(const MIntArray& verticesIds, const MPointArray& points) const;
-    MStatus setBlindData(const int vertexId, std::vector<ClickedCSPosition>& data) const;
-    MStatus getBlindData(const int vertexId, std::vector<ClickedCSPosition>& data) const;
-    MStatus getBlindData(const int vertexId, std::map<int, MPoint>& cameraToClickedCSPoints) const;
+    MStatus getBlindData(MVGObservationTable& observations) const;
+    MStatus setBlindData(const MVGObservationTable& observations,
+                         MDGModifier* modifier = NULL) const;
     MStatus unsetAllBlindData() const;
-    MStatus unsetBlindData(const int vertexId) const;
-    MStatus getBlindDataPerCamera(const int vertexId, const int cameraId, MPoint& point2D) const;
-    MStatus setBlindDataPerCamera(const int vertexId, const int cameraId,
-                                  const MPoint& point2D) const;
-    MStatus unsetBlindDataPerCamera(const int vertexId, const int cameraId) const;
+    MStatus setLegacyBlindDataPerCamera(const int vertexId, const int cameraId,
+                                        const MPoint& point2D) const;
+    MStatus unsetLegacyBlindData(const int vertexId) const;
+
+private:
+    MStatus ensureBlindDataAttribute(MDGModifier* modifier = NULL) const;
+    MStatus getLegacyBlindData(MVGObservationTable& observations) const;
+    MStatus getLegacyBlindData(const int vertexId,
+                               std::vector<ClickedCSPosition>& clickedCSPositions) const;
+    MStatus setLegacyBlindData(const int vertexId,
+                               std::vector<ClickedCSPosition>& clickedCSPositions) const;
 
 private:
     static int _blindDataID;
     static MString _MVG;
+    static MString _MVG_OBSERVATIONS;
 };
 
 } // namespace
@@ -3,7 +3,8 @@
 #include "mayaMVG/core/MVGLog.hpp"
 #include "mayaMVG/core/MVGProject.hpp"
 #include "mayaMVG/core/MVGGeometryUtil.hpp"
-#include "mayaMVG/core/MVGPlaneKernel.hpp"
+#include "mayaMVG/geometry/MVGViewPointGrid.hpp"
+#include "mayaMVG/geometry/MVGVisibilityIndex.hpp"
 #include "mayaMVG/maya/MVGMayaUtil.hpp"
 #include <maya/M3dView.h>
 #include <maya/MFnParticleSystem.h>
@@ -16,6 +17,8 @@
 #include <maya/MFnVectorArrayData.h>
 #include <maya/MPlug.h>
 #include <maya/MMatrix.h>
+#include <maya/MFnDependencyNode.h>
+#include <cstdlib>
 #include <stdexcept>
 
 namespace mayaMVG
@@ -24,44 +27,35 @@ namespace mayaMVG
 namespace
 { // empty namespace
 
-int isLeft(const MPoint& P0, const MPoint& P1, const MPoint& P2)
+/**
+ * Plane estimation on the enclosed point cloud items, which can be numerous: MSAC by default,
+ * the MAYAMVG_PLANE_ESTIMATOR environment variable ("lmeds", "ransac" or "msac") selects another
+ * method.
+ */
+const MVGPlaneEstimatorOptions& getPlaneEstimatorOptions()
 {
-    // isLeft(): tests if a point is Left|On|Right of an infinite line.
-    //    Input:  three points P0, P1, and P2
-    //    Return: >0 for P2 left of the line through P0 and P1
-    //            =0 for P2  on the line
-    //            <0 for P2  right of the line
-    //    See: Algorithm 1 "Area of Triangles and Polygons"
-    return (int)((P1.x - P0.x) * (P2.y - P0.y) - (P2.x - P0.x) * (P1.y - P0.y));
-}
-
-int wn_PnPoly(const MPoint& P, const MPointArray& V)
-{
-    // wn_PnPoly(): winding number test for a point in a polygon
-    //      Input:   P = a point,
-    //               V[] = vertex points of a polygon V[n+1] with V[n]=V[0]
-    //      Return:  wn = the winding number (=0 only when P is outside)
-    int wn = 0;
-    for(int i = 0; i < V.length() - 1; i++)
-    {
-        if(V[i].y <= P.y)
-        {
-            if(V[i + 1].y > P.y)
-                if(isLeft(V[i], V[i + 1], P) > 0)
-                    ++wn;
-        }
-        else
-        {
-            if(V[i + 1].y <= P.y)
-                if(isLeft(V[i], V[i + 1], P) < 0)
-                    --wn;
-        }
-    }
-    return wn;
+    static MVGPlaneEstimatorOptions options;
+    static bool initialized = false;
+    if(initialized)
+        return options;
+    initialized = true;
+    options.method = MVGPlaneEstimatorOptions::kMsac;
+    const char* method = std::getenv("MAYAMVG_PLANE_ESTIMATOR");
+    if(method && !MVGPlaneEstimatorOptions::stringToMethod(method, options.method))
+        LOG_WARNING("Unknown plane estimator " << method);
+    return options;
 }
 
 } // empty namespace
 
+// dynamic attributes
+MString MVGPointCloud::_MVG_VISIBILITY_SIZE = "mvg_visibilitySize";
+MString MVGPointCloud::_MVG_VISIBILITY_IDS = "mvg_visibilityIds";
+
+aliceVision::Mat3X MVGPointCloud::_cachedPositions;
+MObjectHandle MVGPointCloud::_cachedPositionsNode;
+MCallbackId MVGPointCloud::_cachedPositionsCB = 0;
+
 MVGPointCloud::MVGPointCloud(const std::string& name)
     : MVGNodeWrapper(name)
 {
@@ -83,81 +77,158 @@ bool MVGPointCloud::isValid() const
 
 MStatus MVGPointCloud::getItems(std::vector<MVGPointCloudItem>& items) const
 {
-    MStatus status;
     items.clear();
-    MFnParticleSystem fnParticle(_dagpath, &status);
-    CHECK_RETURN_STATUS(status)
-    MVectorArray positionArray;
-    fnParticle.position(positionArray);
-    items.resize(positionArray.length());
-    for(int i = 0; i < positionArray.length(); ++i)
+    if(!isValid())
+        return MS::kFailure;
+    const aliceVision::Mat3X& positions = getPositions();
+    items.resize(positions.cols());
+    for(int i = 0; i < positions.cols(); ++i)
     {
         MVGPointCloudItem& item = items[i];
         item._id = i;
-        item._position = positionArray[i];
+        item._position = TO_MPOINT(positions.col(i));
     }
-    return status;
+    return MS::kSuccess;
 }
 
 MStatus MVGPointCloud::getItems(std::vector<MVGPointCloudItem>& items,
                                 const MIntArray& indexes) const
 {
-    MStatus status;
     items.clear();
+    if(!isValid())
+        return MS::kFailure;
+    const aliceVision::Mat3X& positions = getPositions();
     items.reserve(indexes.length());
-    MFnParticleSystem fnParticle(_dagpath, &status);
-    CHECK_RETURN_STATUS(status)
-    MVectorArray positionArray;
-    fnParticle.position(positionArray);
     for(int i = 0; i < indexes.length(); ++i)
     {
         MVGPointCloudItem item;
         item._id = indexes[i];
-        item._position = positionArray[indexes[i]];
+        item._position = TO_MPOINT(positions.col(indexes[i]));
         items.push_back(item);
     }
+    return MS::kSuccess;
+}
+
+/**
+ * Particle positions are read once, then kept until the particle positions are modified or
+ * another point cloud is requested.
+ *
+ * @return particle positions in world space, one column per particle
+ */
+const aliceVision::Mat3X& MVGPointCloud::getPositions() const
+{
+    const MObject node = _dagpath.node();
+    if(_cachedPositionsNode.isValid() && _cachedPositionsNode.object() == node)
+        return _cachedPositions;
+
+    clearPositionsCache();
+    MStatus status;
+    MFnParticleSystem fnParticle(_dagpath, &status);
+    CHECK_RETURN_VARIABLE(status, _cachedPositions)
+    MVectorArray positionArray;
+    fnParticle.position(positionArray);
+    _cachedPositions.resize(3, positionArray.length());
+    for(unsigned int i = 0; i < positionArray.length(); ++i)
+    {
+        const MVector& position = positionArray[i];
+        _cachedPositions.col(i) = aliceVision::Vec3(position.x, position.y, position.z);
+    }
+    _cachedPositionsNode = MObjectHandle(node);
+    MObject nonConstNode(node);
+    _cachedPositionsCB =
+        MNodeMessage::addAttributeChangedCallback(nonConstNode, positionsChangedCB, NULL, &status);
+    CHECK(status)
+    return _cachedPositions;
+}
+
+/**
+ * @param[in] indexes : particle ids
+ * @param[out] positions : positions of the given particles, one column per particle
+ */
+void MVGPointCloud::getPositions(const MIntArray& indexes, aliceVision::Mat3X& positions) const
+{
+    const aliceVision::Mat3X& allPositions = getPositions();
+    positions.resize(3, indexes.length());
+    for(unsigned int i = 0; i < indexes.length(); ++i)
+        positions.col(i) = allPositions.col(indexes[i]);
+}
+
+void MVGPointCloud::positionsChangedCB(MNodeMessage::AttributeMessage /*msg*/, MPlug& plug,
+                                       MPlug& /*otherPlug*/, void* /*clientData*/)
+{
+    const MObject positionAttr = MFnDependencyNode(plug.node()).attribute("position");
+    // Positions are read again on the next request, don't remove the callback while it runs
+    if(plug == positionAttr)
+        _cachedPositionsNode = MObjectHandle();
+}
+
+void MVGPointCloud::clearPositionsCache()
+{
+    if(_cachedPositionsCB)
+        MMessage::removeCallback(_cachedPositionsCB);
+    _cachedPositionsCB = 0;
+    _cachedPositionsNode = MObjectHandle();
+    _cachedPositions.resize(3, 0);
+}
+
+/**
+ * Build the visibility index from the visibility attributes imported with the Alembic file
+ * (for each point, the number of cameras seeing it, then the view id and feature id of each
+ * observation).
+ */
+MStatus MVGPointCloud::getVisibility(MVGVisibilityIndex& visibility) const
+{
+    MStatus status;
+    MIntArray visibilitySizeArray;
+    status = MVGMayaUtil::getIntArrayAttribute(_dagpath.node(), _MVG_VISIBILITY_SIZE,
+                                               visibilitySizeArray);
+    CHECK_RETURN_STATUS(status)
+    MIntArray visibilityIdsArray;
+    status = MVGMayaUtil::getIntArrayAttribute(_dagpath.node(), _MVG_VISIBILITY_IDS,
+                                               visibilityIdsArray);
+    CHECK_RETURN_STATUS(status)
+
+    std::vector<int> visibilitySizes(visibilitySizeArray.length());
+    if(!visibilitySizes.empty())
+        visibilitySizeArray.get(&visibilitySizes[0]);
+    std::vector<int> visibilityIds(visibilityIdsArray.length());
+    if(!visibilityIds.empty())
+        visibilityIdsArray.get(&visibilityIds[0]);
+    visibility.buildFromPoints(visibilitySizes, visibilityIds, 2);
     return status;
 }
 
 /**
  *
  * @param[in] view
- * @param[in] visibleItems : pointcloud items visible for the current camera
+ * @param[in] visibleIndexes : pointcloud items visible for the current camera
+ * @param[in,out] visiblePointsGrid : view space grid of the visible items, (re)built when the
+ * view has changed
  * @param[in] faceCSPoints : points describing the face in camera space coordinates
  * @param[out] faceWSPoints : faceCSPoints projected on computed plane in world space
  *coordinates
  * @return
  */
-bool MVGPointCloud::projectPoints(M3dView& view, const std::vector<MVGPointCloudItem>& visibleItems,
+bool MVGPointCloud::projectPoints(M3dView& view, const MIntArray& visibleIndexes,
+                                  MVGViewPointGrid& visiblePointsGrid,
                                   const MPointArray& faceCSPoints, MPointArray& faceWSPoints)
 {
     if(!isValid())
         return false;
     if(faceCSPoints.length() < 3)
         return false;
-    if(visibleItems.size() < 3)
+    if(visibleIndexes.length() < 3)
         return false;
 
-    MPointArray closedVSPolygon(MVGGeometryUtil::cameraToViewSpace(view, faceCSPoints));
-    closedVSPolygon.append(closedVSPolygon[0]); // add an extra point (to describe a closed shape)
-
-    // get enclosed items in pointcloud
     MPointArray enclosedWSPoints;
-    std::vector<MVGPointCloudItem>::const_iterator it = visibleItems.begin();
-    int windingNumber = 0;
-    for(; it != visibleItems.end(); ++it)
-    {
-        windingNumber =
-            wn_PnPoly(MVGGeometryUtil::worldToViewSpace(view, it->_position), closedVSPolygon);
-        if(windingNumber != 0)
-            enclosedWSPoints.append(it->_position);
-    }
+    getEnclosedPoints(view, visibleIndexes, visiblePointsGrid, faceCSPoints, enclosedWSPoints);
     if(enclosedWSPoints.length() < 3)
         return false;
 
     // Compute plane
     PlaneKernel::Model model;
-    MVGGeometryUtil::computePlane(enclosedWSPoints, model);
+    if(!MVGGeometryUtil::computePlane(enclosedWSPoints, model, getPlaneEstimatorOptions()))
+        return false;
     // Project points
     return MVGGeometryUtil::projectPointsOnPlane(view, faceCSPoints, model, faceWSPoints);
 }
@@ -165,7 +236,9 @@ bool MVGPointCloud::projectPoints(M3dView& view, const std::vector<MVGPointCloud
 /**
  *
  * @param[in] view
- * @param[in] visibleItems : pointcloud items visible for the current camera
+ * @param[in] visibleIndexes : pointcloud items visible for the current camera
+ * @param[in,out] visiblePointsGrid : view space grid of the visible items, (re)built when the
+ * view has changed
  * @param[in] faceCSPoints : points describing the face in camera space coordinates
  * @param[in] constraintedWSPoints : points describing the line constraint in world space
  *coordinates
@@ -174,7 +247,7 @@ bool MVGPointCloud::projectPoints(M3dView& view, const std::vector<MVGPointCloud
  * @return
  */
 bool MVGPointCloud::projectPointsWithLineConstraint(
-    M3dView& view, const std::vector<MVGPointCloudItem>& visibleItems,
+    M3dView& view, const MIntArray& visibleIndexes, MVGViewPointGrid& visiblePointsGrid,
     const MPointArray& faceCSPoints, const MPointArray& constraintedWSPoints,
     const MPoint& mouseCSPoint, MPoint& projectedWSMouse)
 {
@@ -182,35 +255,64 @@ bool MVGPointCloud::projectPointsWithLineConstraint(
         return false;
     if(faceCSPoints.length() < 3)
         return false;
-    if(visibleItems.size() < 3)
+    if(visibleIndexes.length() < 3)
         return false;
     if(constraintedWSPoints.length() < 2)
         return false;
 
-    MPointArray closedVSPolygon(MVGGeometryUtil::cameraToViewSpace(view, faceCSPoints));
-    closedVSPolygon.append(closedVSPolygon[0]); // add an extra point (to describe a closed shape)
-
-    // get enclosed items in pointcloud
     MPointArray enclosedWSPoints;
-    std::vector<MVGPointCloudItem>::const_iterator it = visibleItems.begin();
-    int windingNumber = 0;
-    for(; it != visibleItems.end(); ++it)
-    {
-        windingNumber =
-            wn_PnPoly(MVGGeometryUtil::worldToViewSpace(view, it->_position), closedVSPolygon);
-        if(windingNumber != 0)
-            enclosedWSPoints.append(it->_position);
-    }
+    getEnclosedPoints(view, visibleIndexes, visiblePointsGrid, faceCSPoints, enclosedWSPoints);
     if(enclosedWSPoints.length() < 3)
         return false;
 
     LineConstrainedPlaneKernel::Model model;
-    MVGGeometryUtil::computePlaneWithLineConstraint(enclosedWSPoints, constraintedWSPoints, model);
+    if(!MVGGeometryUtil::computePlaneWithLineConstraint(enclosedWSPoints, constraintedWSPoints,
+                                                        model, getPlaneEstimatorOptions()))
+        return false;
 
     // Project the mouse point
     return MVGGeometryUtil::projectPointOnPlane(view, mouseCSPoint, model, projectedWSMouse);
 }
 
+/**
+ * @param[in] view
+ * @param[in] visibleIndexes : pointcloud items visible for the current camera
+ * @param[in,out] visiblePointsGrid : view space grid of the visible items
+ * @param[in] faceCSPoints : points describing the face in camera space coordinates
+ * @param[out] enclosedWSPoints : visible items enclosed by the face, in world space coordinates
+ */
+void MVGPointCloud::getEnclosedPoints(M3dView& view, const MIntArray& visibleIndexes,
+                                      MVGViewPointGrid& visiblePointsGrid,
+                                      const MPointArray& faceCSPoints,
+                                      MPointArray& enclosedWSPoints) const
+{
+    enclosedWSPoints.clear();
+    const MPointArray faceVSPoints(MVGGeometryUtil::cameraToViewSpace(view, faceCSPoints));
+    // add an extra point (to describe a closed shape)
+    aliceVision::Mat2X closedVSPolygon(2, faceVSPoints.length() + 1);
+    for(size_t i = 0; i < faceVSPoints.length(); ++i)
+        closedVSPolygon.col(i) = aliceVision::Vec2(faceVSPoints[i].x, faceVSPoints[i].y);
+    closedVSPolygon.col(faceVSPoints.length()) = closedVSPolygon.col(0);
+
+    // view space positions are only computed again when the view has changed
+    MVGViewProjection projection;
+    MVGGeometryUtil::getViewProjection(view, projection);
+    if(!visiblePointsGrid.isBuilt(projection))
+    {
+        aliceVision::Mat3X visibleWSPoints;
+        getPositions(visibleIndexes, visibleWSPoints);
+        visiblePointsGrid.build(projection, visibleWSPoints);
+    }
+
+    // get enclosed items in pointcloud
+    const aliceVision::Mat3X& positions = getPositions();
+    std::vector<int> enclosedIndexes;
+    visiblePointsGrid.getEnclosedPoints(closedVSPolygon, enclosedIndexes);
+    enclosedWSPoints.setLength(enclosedIndexes.size());
+    for(size_t i = 0; i < enclosedIndexes.size(); ++i)
+        enclosedWSPoints[i] = TO_MPOINT(positions.col(visibleIndexes[enclosedIndexes[i]]));
+}
+
 MStatus MVGPointCloud::setOpacity(double value)
 {
     MFnParticleSystem fn(_dagpath);
@@ -227,6 +329,21 @@ MStatus MVGPointCloud::setOpacity(const MIntArray &indices, double value)
     return setOpacityPPAttribute(array);
 }
 
+/**
+ * @param[in] values : opacity of each particle, particles without value are hidden
+ */
+MStatus MVGPointCloud::setOpacity(const MDoubleArray& values)
+{
+    MFnParticleSystem fn(_dagpath);
+    MDoubleArray array(values);
+    const unsigned int count = fn.count();
+    const unsigned int valueCount = values.length();
+    array.setLength(count);
+    for(unsigned int i = valueCount; i < count; ++i)
+        array[i] = 0.0;
+    return setOpacityPPAttribute(array);
+}
+
 MStatus MVGPointCloud::getOpacityPP(MDoubleArray& values)
 {
     MStatus status;
@@ -2,8 +2,12 @@
 
 #include "mayaMVG/core/MVGNodeWrapper.hpp"
 #include "mayaMVG/core/MVGPointCloudItem.hpp"
+#include "mayaMVG/core/MVGEigen.hpp"
+#include <maya/MObjectHandle.h>
+#include <maya/MNodeMessage.h>
 #include <vector>
 
+class MString;
 class MIntArray;
 class MPointArray;
 class M3dView;
@@ -13,6 +17,8 @@ namespace mayaMVG
 
 class MVGCamera;
 class MVGPointCloudItem;
+class MVGVisibilityIndex;
+class MVGViewPointGrid;
 
 class MVGPointCloud : public MVGNodeWrapper
 {
@@ -28,23 +34,45 @@ public:
 public:
     MStatus getItems(std::vector<MVGPointCloudItem>& items) const;
     MStatus getItems(std::vector<MVGPointCloudItem>& items, const MIntArray& indexes) const;
-    bool projectPoints(M3dView& view, const std::vector<MVGPointCloudItem>& visibleItems,
-                       const MPointArray& faceCSPoints, MPointArray& faceWSPoints);
-    bool projectPointsWithLineConstraint(M3dView& view,
-                                         const std::vector<MVGPointCloudItem>& visibleItems,
+    MStatus getVisibility(MVGVisibilityIndex& visibility) const;
+    const aliceVision::Mat3X& getPositions() const;
+    void getPositions(const MIntArray& indexes, aliceVision::Mat3X& positions) const;
+    bool projectPoints(M3dView& view, const MIntArray& visibleIndexes,
+                       MVGViewPointGrid& visiblePointsGrid, const MPointArray& faceCSPoints,
+                       MPointArray& faceWSPoints);
+    bool projectPointsWithLineConstraint(M3dView& view, const MIntArray& visibleIndexes,
+                                         MVGViewPointGrid& visiblePointsGrid,
                                          const MPointArray& faceCSPoints,
                                          const MPointArray& constraintedWSPoints,
                                          const MPoint& mouseCSPoint, MPoint& projectedWSMouse);
 
     MStatus setOpacity(double value);
     MStatus setOpacity(const MIntArray& indices, double value);
+    MStatus setOpacity(const MDoubleArray& values);
 
 protected:
     MStatus getOpacityPP(MDoubleArray& values);
     MStatus setOpacityPPAttribute(MDoubleArray& values);
 private:
     MStatus ensureOpacityPPAttribute();
+    void getEnclosedPoints(M3dView& view, const MIntArray& visibleIndexes,
+                           MVGViewPointGrid& visiblePointsGrid, const MPointArray& faceCSPoints,
+                           MPointArray& enclosedWSPoints) const;
 
+public:
+    static void clearPositionsCache();
+
+private:
+    static void positionsChangedCB(MNodeMessage::AttributeMessage msg, MPlug& plug,
+                                   MPlug& otherPlug, void* clientData);
+
+private:
+    static MString _MVG_VISIBILITY_SIZE;
+    static MString _MVG_VISIBILITY_IDS;
+    /// Particle positions (one column per particle), shared by all wrappers of the same node
+    static aliceVision::Mat3X _cachedPositions;
+    static MObjectHandle _cachedPositionsNode;
+    static MCallbackId _cachedPositionsCB;
 };
 
 } // namespace
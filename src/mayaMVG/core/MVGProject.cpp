@@ -1,5 +1,6 @@
 #include "mayaMVG/core/MVGProject.hpp"
 #include "mayaMVG/core/MVGCamera.hpp"
+#include "mayaMVG/core/MVGCameraRegistry.hpp"
 #include "mayaMVG/core/MVGMesh.hpp"
 #include "mayaMVG/core/MVGLog.hpp"
 #include "mayaMVG/maya/context/MVGContextCmd.hpp"
@@ -57,6 +58,15 @@ void unlockNode(MObject obj)
         unlockNode(fn.child(i));
 }
 
+/**
+ * Estimated memory used by the image plane texture of a camera (RGBA, 8 bits per channel)
+ */
+size_t getImageMemorySize(const mayaMVG::MVGCamera& camera)
+{
+    const std::pair<double, double> imageSize = camera.getImageSize();
+    return static_cast<size_t>(imageSize.first * imageSize.second) * 4;
+}
+
 } // empty namespace
 
 namespace mayaMVG
@@ -78,6 +88,9 @@ std::string MVGProject::_CAMERASET_PREFIX = "mvgCamset_";
 // Image cache
 // List of camera by name or dagpath according to uniqueness
 std::list<std::string> MVGProject::_cachedImagePlanes;
+std::map<std::string, size_t> MVGProject::_cachedImagePlaneSizes;
+size_t MVGProject::_cachedImagePlanesSize = 0;
+size_t MVGProject::_imageCacheBudget = size_t(512) * 1024 * 1024;
 std::map<std::string, std::string> MVGProject::_lastLoadedCameraByView;
 
 MVGProject::MVGProject(const std::string& name)
@@ -221,6 +234,9 @@ bool MVGProject::applySceneTransformation() const
         lockNode(transformObj);
     }
 
+    // Cameras have moved with the root node
+    MVGCameraRegistry::invalidate();
+
     return true;
 }
 
@@ -313,6 +329,11 @@ void MVGProject::lockProject() const
     lockNode(cloudGroup);
 }
 
+/**
+ * Push a camera whose image is loaded but no longer displayed as the most recently used one.
+ * Least recently used images are unloaded until the cache fits in the memory budget.
+ * @param cameraName
+ */
 void MVGProject::pushImageInCache(const std::string& cameraName)
 {
     if(cameraName.empty())
@@ -321,16 +342,24 @@ void MVGProject::pushImageInCache(const std::string& cameraName)
     std::list<std::string>::iterator camera =
         std::find(_cachedImagePlanes.begin(), _cachedImagePlanes.end(), cameraName);
     if(camera != _cachedImagePlanes.end()) // Camera is already in the list
-        return;
+        _cachedImagePlanes.splice(_cachedImagePlanes.end(), _cachedImagePlanes, camera);
+    else
+    {
+        const size_t imageSize = getImageMemorySize(MVGCamera(cameraName));
+        _cachedImagePlanes.push_back(cameraName);
+        _cachedImagePlaneSizes[cameraName] = imageSize;
+        _cachedImagePlanesSize += imageSize;
+    }
 
-    if(_cachedImagePlanes.size() == IMAGE_CACHE_SIZE)
+    while(_cachedImagePlanesSize > _imageCacheBudget && !_cachedImagePlanes.empty())
     {
-        std::string frontCamera = _cachedImagePlanes.front();
+        const std::string frontCamera = _cachedImagePlanes.front();
         MVGCamera camera(frontCamera);
         camera.unloadImagePlane();
+        _cachedImagePlanesSize -= _cachedImagePlaneSizes[frontCamera];
+        _cachedImagePlaneSizes.erase(frontCamera);
         _cachedImagePlanes.pop_front();
     }
-    _cachedImagePlanes.push_back(cameraName);
 }
 
 const std::string MVGProject::getLastLoadedCameraInView(const std::string& viewName) const
@@ -359,10 +388,13 @@ void MVGProject::updateImageCache(const std::string& newCameraName,
                                   const std::string& oldCameraName)
 {
     // If new camera is in cache remove from cacheList
-    std::list<std::string>::iterator cameraIt =
-        std::find(_cachedImagePlanes.begin(), _cachedImagePlanes.end(), newCameraName);
-    if(cameraIt != _cachedImagePlanes.end())
+    std::map<std::string, size_t>::iterator cameraIt = _cachedImagePlaneSizes.find(newCameraName);
+    if(cameraIt != _cachedImagePlaneSizes.end())
+    {
+        _cachedImagePlanesSize -= cameraIt->second;
+        _cachedImagePlaneSizes.erase(cameraIt);
         _cachedImagePlanes.remove(newCameraName);
+    }
 
     if(oldCameraName != newCameraName)
         pushImageInCache(oldCameraName);
@@ -374,6 +406,53 @@ void MVGProject::updateImageCache(const std::string& newCameraName,
 void MVGProject::clearImageCache()
 {
     _cachedImagePlanes.clear();
+    _cachedImagePlaneSizes.clear();
+    _cachedImagePlanesSize = 0;
+}
+
+/**
+ * Load the image of a camera which is not displayed yet, if it fits in the free memory of the
+ * cache: prefetching never unloads images.
+ * @param cameraName
+ * @return true if the image is loaded or cached
+ */
+bool MVGProject::prefetchImagePlane(const std::string& cameraName)
+{
+    if(cameraName.empty())
+        return false;
+    // Already displayed
+    for(std::map<std::string, std::string>::const_iterator it = _lastLoadedCameraByView.begin();
+        it != _lastLoadedCameraByView.end(); ++it)
+    {
+        if(it->second == cameraName)
+            return true;
+    }
+    if(_cachedImagePlaneSizes.count(cameraName))
+        return true;
+
+    MVGCamera camera(cameraName);
+    if(!camera.isValid())
+        return false;
+    const size_t imageSize = getImageMemorySize(camera);
+    if(_cachedImagePlanesSize + imageSize > _imageCacheBudget)
+        return false;
+    camera.loadImagePlane();
+    // Least recently used position: prefetched images are only guesses
+    _cachedImagePlanes.push_front(cameraName);
+    _cachedImagePlaneSizes[cameraName] = imageSize;
+    _cachedImagePlanesSize += imageSize;
+    return true;
+}
+
+/**
+ * @param budget : maximum memory of the cached images (not displayed in a panel), in bytes
+ */
+void MVGProject::setImageCacheBudget(const size_t budget)
+{
+    _imageCacheBudget = budget;
+    // Unload the least recently used images if needed
+    if(!_cachedImagePlanes.empty())
+        pushImageInCache(_cachedImagePlanes.back());
 }
 
 /**
@@ -392,4 +471,21 @@ void MVGProject::pushLoadCurrentImagePlaneCommand(const std::string& panelName)
     CHECK_RETURN(status)
 }
 
+/**
+ * Push one command per camera to the idle queue, loading its image ahead of time.
+ * Cameras are given by decreasing probability of being displayed next.
+ * @param cameraNames
+ */
+void MVGProject::pushPrefetchImagePlaneCommands(const std::vector<std::string>& cameraNames) const
+{
+    MStatus status;
+    for(size_t i = 0; i < cameraNames.size(); ++i)
+    {
+        MString cmd;
+        cmd.format("MVGImagePlaneCmd -prefetch \"^1s\"", cameraNames[i].c_str());
+        status = MGlobal::executeCommandOnIdle(cmd);
+        CHECK_RETURN(status)
+    }
+}
+
 } // namespace
@@ -10,7 +10,6 @@
 
 namespace mayaMVG
 {
-#define IMAGE_CACHE_SIZE 3
 
 class MVGCamera;
 class MVGPointCloud;
@@ -48,10 +47,14 @@ public:
     const std::string getLastLoadedCameraInView(const std::string& viewName) const;
     void setLastLoadedCameraInView(const std::string& viewName, const std::string& cameraName);
     void pushLoadCurrentImagePlaneCommand(const std::string& panelName) const;
+    void pushPrefetchImagePlaneCommands(const std::vector<std::string>& cameraNames) const;
     void pushImageInCache(const std::string& cameraName);
     void updateImageCache(const std::string& newCameraName, const std::string& oldCameraName);
+    bool prefetchImagePlane(const std::string& cameraName);
     const std::list<std::string>& getImageCache() { return _cachedImagePlanes; };
     void clearImageCache();
+    size_t getImageCacheBudget() const { return _imageCacheBudget; }
+    void setImageCacheBudget(const size_t budget);
 
 public:
     // aliceVision node names
@@ -68,9 +71,14 @@ public:
     static MString _MVG_PROJECTPATH;
     static std::string _CAMERASET_PREFIX;
 
-    /// FIFO queue indicating the list of images/cameras keept in memory
+    /// LRU list of the images/cameras kept in memory, least recently used first.
     /// Cameras corresponding to current images seen in panels are not stored in this list.
     static std::list<std::string> _cachedImagePlanes;
+    /// Estimated memory of each cached image, in bytes
+    static std::map<std::string, size_t> _cachedImagePlaneSizes;
+    static size_t _cachedImagePlanesSize;
+    /// Maximum memory of the cached images, in bytes
+    static size_t _imageCacheBudget;
     /// Stores the camera name of the last image plane loaded in each view.
     /// The user can change the camera of the view faster than what Maya is
     /// able to do with the loading time of image planes.
@@ -0,0 +1,170 @@
+#include "mayaMVG/geometry/MVGCameraIndex.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace mayaMVG
+{
+
+MVGCameraIndex::MVGCameraIndex()
+{
+}
+
+void MVGCameraIndex::clear()
+{
+    _ids.clear();
+    _centers.resize(3, 0);
+    _directions.resize(3, 0);
+    _axes.clear();
+}
+
+/**
+ * @param[in] ids : camera identifiers, returned by the queries
+ * @param[in] centers : camera centres in world space (one column per camera)
+ * @param[in] directions : normalized viewing directions in world space (one column per camera)
+ */
+void MVGCameraIndex::build(const std::vector<int>& ids, const aliceVision::Mat3X& centers,
+                           const aliceVision::Mat3X& directions)
+{
+    clear();
+    const int cameraCount = static_cast<int>(ids.size());
+    if(cameraCount == 0 || centers.cols() != cameraCount || directions.cols() != cameraCount)
+        return;
+
+    // Build on a permutation, then reorder the data along the tree
+    std::vector<int> order(cameraCount);
+    std::iota(order.begin(), order.end(), 0);
+    _ids = order;
+    _centers = centers;
+    _axes.assign(cameraCount, 0);
+    buildRange(0, cameraCount);
+
+    std::vector<int> sortedIds(cameraCount);
+    aliceVision::Mat3X sortedCenters(3, cameraCount);
+    _directions.resize(3, cameraCount);
+    for(int i = 0; i < cameraCount; ++i)
+    {
+        sortedIds[i] = ids[_ids[i]];
+        sortedCenters.col(i) = centers.col(_ids[i]);
+        _directions.col(i) = directions.col(_ids[i]);
+    }
+    _ids.swap(sortedIds);
+    _centers.swap(sortedCenters);
+}
+
+/**
+ * @param[in] point : world space position
+ * @param[in] count : maximum number of cameras
+ * @param[out] ids : identifiers of the cameras with the closest centres, closest first
+ */
+void MVGCameraIndex::findNearest(const aliceVision::Vec3& point, const int count,
+                                 std::vector<int>& ids) const
+{
+    ids.clear();
+    if(count <= 0 || isEmpty())
+        return;
+    std::vector<Neighbour> neighbours;
+    searchRange(0, getCameraCount(), point, NULL, 0.0, count, neighbours);
+    std::sort_heap(neighbours.begin(), neighbours.end());
+    for(size_t i = 0; i < neighbours.size(); ++i)
+        ids.push_back(_ids[neighbours[i].second]);
+}
+
+/**
+ * @param[in] point : world space position of the viewpoint
+ * @param[in] direction : normalized viewing direction
+ * @param[in] directionWeight : world distance equivalent to opposite directions, divided by 2
+ * @param[in] count : maximum number of cameras
+ * @param[out] ids : identifiers of the closest cameras, closest first
+ */
+void MVGCameraIndex::findNearest(const aliceVision::Vec3& point, const aliceVision::Vec3& direction,
+                                 const double directionWeight, const int count,
+                                 std::vector<int>& ids) const
+{
+    ids.clear();
+    if(count <= 0 || isEmpty())
+        return;
+    std::vector<Neighbour> neighbours;
+    searchRange(0, getCameraCount(), point, &direction, directionWeight * directionWeight, count,
+                neighbours);
+    std::sort_heap(neighbours.begin(), neighbours.end());
+    for(size_t i = 0; i < neighbours.size(); ++i)
+        ids.push_back(_ids[neighbours[i].second]);
+}
+
+/**
+ * Split the range on the axis of largest extent, at the median.
+ * _ids holds the permutation being built, _centers the unsorted centres.
+ */
+void MVGCameraIndex::buildRange(const int begin, const int end)
+{
+    if(end - begin <= 1)
+        return;
+    aliceVision::Vec3 minCenter = _centers.col(_ids[begin]);
+    aliceVision::Vec3 maxCenter = minCenter;
+    for(int i = begin + 1; i < end; ++i)
+    {
+        minCenter = minCenter.cwiseMin(_centers.col(_ids[i]));
+        maxCenter = maxCenter.cwiseMax(_centers.col(_ids[i]));
+    }
+    int axis = 0;
+    (maxCenter - minCenter).maxCoeff(&axis);
+
+    const int median = begin + (end - begin) / 2;
+    const aliceVision::Mat3X& centers = _centers;
+    std::nth_element(_ids.begin() + begin, _ids.begin() + median, _ids.begin() + end,
+                     [&centers, axis](const int a, const int b)
+                     {
+                         return centers(axis, a) < centers(axis, b);
+                     });
+    _axes[median] = axis;
+    buildRange(begin, median);
+    buildRange(median + 1, end);
+}
+
+/**
+ * @param[in,out] neighbours : max heap of the best candidates found so far
+ */
+void MVGCameraIndex::searchRange(const int begin, const int end, const aliceVision::Vec3& point,
+                                 const aliceVision::Vec3* direction,
+                                 const double squaredDirectionWeight, const size_t count,
+                                 std::vector<Neighbour>& neighbours) const
+{
+    if(begin >= end)
+        return;
+    const int median = begin + (end - begin) / 2;
+    double squaredDistance = (_centers.col(median) - point).squaredNorm();
+    if(direction)
+        squaredDistance +=
+            squaredDirectionWeight * (_directions.col(median) - *direction).squaredNorm();
+    if(neighbours.size() < count)
+    {
+        neighbours.push_back(Neighbour(squaredDistance, median));
+        std::push_heap(neighbours.begin(), neighbours.end());
+    }
+    else if(squaredDistance < neighbours.front().first)
+    {
+        std::pop_heap(neighbours.begin(), neighbours.end());
+        neighbours.back() = Neighbour(squaredDistance, median);
+        std::push_heap(neighbours.begin(), neighbours.end());
+    }
+
+    const int axis = _axes[median];
+    const double offset = point(axis) - _centers(axis, median);
+    const bool isLeftFirst = offset < 0.0;
+    if(isLeftFirst)
+        searchRange(begin, median, point, direction, squaredDirectionWeight, count, neighbours);
+    else
+        searchRange(median + 1, end, point, direction, squaredDirectionWeight, count, neighbours);
+    // The other side is at least at |offset| from the point
+    if(neighbours.size() < count || offset * offset < neighbours.front().first)
+    {
+        if(isLeftFirst)
+            searchRange(median + 1, end, point, direction, squaredDirectionWeight, count,
+                        neighbours);
+        else
+            searchRange(begin, median, point, direction, squaredDirectionWeight, count,
+                        neighbours);
+    }
+}
+
+} // namespace
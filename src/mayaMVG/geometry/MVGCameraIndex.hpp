@@ -0,0 +1,51 @@
+#pragma once
+
+#include "mayaMVG/core/MVGEigen.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace mayaMVG
+{
+
+/**
+ * k-d tree over camera centres, answering k-nearest camera queries.
+ * Queries may also compare viewing directions: the distance is then
+ * |center - point|^2 + directionWeight^2 * |direction - queryDirection|^2, the tree still
+ * pruning on the centres only (the direction term being positive, results are exact).
+ */
+class MVGCameraIndex
+{
+public:
+    MVGCameraIndex();
+
+public:
+    void clear();
+    bool isEmpty() const { return _ids.empty(); }
+    int getCameraCount() const { return static_cast<int>(_ids.size()); }
+
+    void build(const std::vector<int>& ids, const aliceVision::Mat3X& centers,
+               const aliceVision::Mat3X& directions);
+    void findNearest(const aliceVision::Vec3& point, const int count,
+                     std::vector<int>& ids) const;
+    void findNearest(const aliceVision::Vec3& point, const aliceVision::Vec3& direction,
+                     const double directionWeight, const int count, std::vector<int>& ids) const;
+
+private:
+    typedef std::pair<double, int> Neighbour; // (squared distance, position in the tree)
+
+    void buildRange(const int begin, const int end);
+    void searchRange(const int begin, const int end, const aliceVision::Vec3& point,
+                     const aliceVision::Vec3* direction, const double squaredDirectionWeight,
+                     const size_t count, std::vector<Neighbour>& neighbours) const;
+
+private:
+    // Tree stored implicitly: the node of range [begin, end) is its median element, splitting
+    // the range on _axes[median]
+    std::vector<int> _ids;
+    aliceVision::Mat3X _centers;
+    aliceVision::Mat3X _directions;
+    std::vector<int> _axes;
+};
+
+} // namespace
@@ -0,0 +1,299 @@
+#include "mayaMVG/geometry/MVGGeometry.hpp"
+#include <aliceVision/multiview/triangulation/Triangulation.hpp>
+#include <aliceVision/multiview/projection.hpp>
+
+namespace mayaMVG
+{
+
+namespace
+{ // empty namespace
+
+double isLeft(const aliceVision::Vec2& P0, const aliceVision::Vec2& P1,
+              const aliceVision::Vec2& P2)
+{
+    // isLeft(): tests if a point is Left|On|Right of an infinite line.
+    //    Input:  three points P0, P1, and P2
+    //    Return: >0 for P2 left of the line through P0 and P1
+    //            =0 for P2  on the line
+    //            <0 for P2  right of the line
+    //    See: Algorithm 1 "Area of Triangles and Polygons"
+    return (P1(0) - P0(0)) * (P2(1) - P0(1)) - (P2(0) - P0(0)) * (P1(1) - P0(1));
+}
+
+} // empty namespace
+
+MVGViewProjection::MVGViewProjection()
+    : viewportWidth(0.0)
+    , viewportHeight(0.0)
+    , portWidth(1.0)
+    , portHeight(1.0)
+    , filmScale(1.0)
+    , horizontalPan(0.0)
+    , verticalPan(0.0)
+{
+    for(int i = 0; i < 4; ++i)
+        for(int j = 0; j < 4; ++j)
+            worldToClip[i][j] = (i == j) ? 1.0 : 0.0;
+}
+
+bool MVGViewProjection::operator==(const MVGViewProjection& other) const
+{
+    for(int i = 0; i < 4; ++i)
+        for(int j = 0; j < 4; ++j)
+            if(worldToClip[i][j] != other.worldToClip[i][j])
+                return false;
+    return viewportWidth == other.viewportWidth && viewportHeight == other.viewportHeight &&
+           portWidth == other.portWidth && portHeight == other.portHeight &&
+           filmScale == other.filmScale && horizontalPan == other.horizontalPan &&
+           verticalPan == other.verticalPan;
+}
+
+void MVGGeometry::worldToViewSpace(const MVGViewProjection& projection,
+                                   const aliceVision::Vec3& worldPoint,
+                                   aliceVision::Vec2& viewPoint)
+{
+    const double(*m)[4] = projection.worldToClip;
+    const double x = worldPoint(0) * m[0][0] + worldPoint(1) * m[1][0] +
+                     worldPoint(2) * m[2][0] + m[3][0];
+    const double y = worldPoint(0) * m[0][1] + worldPoint(1) * m[1][1] +
+                     worldPoint(2) * m[2][1] + m[3][1];
+    const double w = worldPoint(0) * m[0][3] + worldPoint(1) * m[1][3] +
+                     worldPoint(2) * m[2][3] + m[3][3];
+    // truncated to pixels, as M3dView does
+    viewPoint(0) = static_cast<int>(projection.viewportWidth * (x / w + 1.0) / 2.0);
+    viewPoint(1) = static_cast<int>(projection.viewportHeight * (y / w + 1.0) / 2.0);
+}
+
+void MVGGeometry::viewToCameraSpace(const MVGViewProjection& projection,
+                                    const aliceVision::Vec2& viewPoint,
+                                    aliceVision::Vec2& cameraPoint)
+{
+    const double portRatio = projection.portHeight / projection.portWidth;
+    cameraPoint(0) = ((viewPoint(0) / projection.portWidth) - 0.5) * projection.filmScale +
+                     projection.horizontalPan;
+    cameraPoint(1) = ((viewPoint(1) / projection.portWidth) - 0.5 - 0.5 * (portRatio - 1.0)) *
+                         projection.filmScale +
+                     projection.verticalPan;
+}
+
+/**
+ * Project an array of world space points in view space.
+ * Computations are done on whole arrays to benefit from Eigen vectorization.
+ *
+ * @param[in] projection : view parameters retrieved with MVGGeometryUtil::getViewProjection
+ * @param[in] worldPoints : points in world space (one point per column)
+ * @param[out] viewPoints : points in view space, truncated to pixels (one point per column)
+ */
+void MVGGeometry::worldToViewSpace(const MVGViewProjection& projection,
+                                   const aliceVision::Mat3X& worldPoints,
+                                   aliceVision::Mat2X& viewPoints)
+{
+    typedef Eigen::Matrix<double, 4, 4, Eigen::RowMajor> RowMajorMat4;
+    viewPoints.resize(2, worldPoints.cols());
+    if(worldPoints.cols() == 0)
+        return;
+    // clip = transpose(worldToClip) * [point; 1]
+    const Eigen::Map<const RowMajorMat4> worldToClip(&projection.worldToClip[0][0]);
+    const Eigen::Matrix<double, 4, 4> clipFromWorld = worldToClip.transpose();
+    Eigen::Matrix<double, 4, Eigen::Dynamic> clipPoints = clipFromWorld.leftCols<3>() * worldPoints;
+    clipPoints.colwise() += clipFromWorld.col(3);
+    // truncated to pixels, as in worldToViewSpace
+    viewPoints.row(0) =
+        (projection.viewportWidth * (clipPoints.row(0).array() / clipPoints.row(3).array() + 1.0) /
+         2.0)
+            .cast<int>()
+            .cast<double>()
+            .matrix();
+    viewPoints.row(1) =
+        (projection.viewportHeight *
+         (clipPoints.row(1).array() / clipPoints.row(3).array() + 1.0) / 2.0)
+            .cast<int>()
+            .cast<double>()
+            .matrix();
+}
+
+/**
+ * Project an array of world space points in camera space.
+ * Computations are done on whole arrays to benefit from Eigen vectorization.
+ *
+ * @param[in] projection : view parameters retrieved with MVGGeometryUtil::getViewProjection
+ * @param[in] worldPoints : points in world space (one point per column)
+ * @param[out] xs : x coordinates in camera space
+ * @param[out] ys : y coordinates in camera space
+ */
+void MVGGeometry::worldToCameraSpace(const MVGViewProjection& projection,
+                                     const aliceVision::Mat3X& worldPoints,
+                                     std::vector<double>& xs, std::vector<double>& ys)
+{
+    typedef Eigen::Array<double, 1, Eigen::Dynamic> RowArray;
+    const size_t count = worldPoints.cols();
+    xs.resize(count);
+    ys.resize(count);
+    if(count == 0)
+        return;
+    aliceVision::Mat2X viewPoints;
+    worldToViewSpace(projection, worldPoints, viewPoints);
+    // camera space
+    const double portRatio = projection.portHeight / projection.portWidth;
+    Eigen::Map<RowArray>(&xs[0], count) =
+        ((viewPoints.row(0).array() / projection.portWidth) - 0.5) * projection.filmScale +
+        projection.horizontalPan;
+    Eigen::Map<RowArray>(&ys[0], count) =
+        ((viewPoints.row(1).array() / projection.portWidth) - 0.5 - 0.5 * (portRatio - 1.0)) *
+            projection.filmScale +
+        projection.verticalPan;
+}
+
+/**
+ * @param[in] horizontalFilmAperture : camera horizontal film aperture
+ * @param[in] imageWidth, imageHeight : sensor size in pixels
+ * @param[in] cameraPoint : point in camera space
+ * @param[out] imagePoint : point in image space (pixels)
+ */
+void MVGGeometry::cameraToImageSpace(const double horizontalFilmAperture, const double imageWidth,
+                                     const double imageHeight, const aliceVision::Vec2& cameraPoint,
+                                     aliceVision::Vec2& imagePoint)
+{
+    assert(horizontalFilmAperture != 0.0);
+    const aliceVision::Vec2 pointCenteredNorm = cameraPoint / horizontalFilmAperture;
+    const double verticalMargin = (imageWidth - imageHeight) / 2.0;
+    imagePoint(0) = (pointCenteredNorm(0) + 0.5) * imageWidth;
+    imagePoint(1) = (-pointCenteredNorm(1) + 0.5) * imageWidth - verticalMargin;
+}
+
+/**
+ *
+ * @param[in] points : all points used to compute plane (one point per column)
+ * @param[out] model : computed plane
+ * @param[in] options : robust estimation method and parameters
+ * @return
+ */
+bool MVGGeometry::computePlane(const aliceVision::Mat& points, PlaneKernel::Model& model,
+                               const MVGPlaneEstimatorOptions& options)
+{
+    if(points.cols() < 3)
+        return false;
+    PlaneKernel kernel(points);
+    MVGPlaneEstimator estimator(options);
+    return estimator.estimate(kernel, model);
+}
+
+/**
+ *
+ * @param[in] points : all points used to compute plane (one point per column)
+ * @param[in] constraintP0, constraintP1 : points describing the line constraint
+ * @param[out] model : computed plane
+ * @return
+ */
+bool MVGGeometry::computePlaneWithLineConstraint(const aliceVision::Mat& points,
+                                                 const aliceVision::Vec3& constraintP0,
+                                                 const aliceVision::Vec3& constraintP1,
+                                                 LineConstrainedPlaneKernel::Model& model,
+                                                 const MVGPlaneEstimatorOptions& options)
+{
+    if(points.cols() < 3)
+        return false;
+    LineConstrainedPlaneKernel kernel(points, constraintP0, constraintP1);
+    MVGPlaneEstimator estimator(options);
+    return estimator.estimate(kernel, model);
+}
+
+/**
+ * @param[in] K : intrinsic matrix
+ * @param[in] R : rotation matrix (world to camera)
+ * @param[in] C : camera center in world space
+ * @param[out] P : projection matrix
+ */
+void MVGGeometry::computeProjectionMatrix(const aliceVision::Mat3& K, const aliceVision::Mat3& R,
+                                          const aliceVision::Vec3& C, aliceVision::Mat34& P)
+{
+    const aliceVision::Vec3 t = -R * C;
+    aliceVision::P_From_KRt(K, R, t, &P);
+}
+
+/**
+ * @brief N-View triangulation.
+ *
+ * @param[in] imagePoints : 2d points in image space (one column per camera)
+ * @param[in] projectionMatrices : projection matrix of each camera
+ * @param[out] triangulatedPoint : 3D triangulated point
+ * @return false if the triangulated point is at infinity (w = 0)
+ */
+bool MVGGeometry::triangulatePoint(const aliceVision::Mat2X& imagePoints,
+                                   const std::vector<aliceVision::Mat34>& projectionMatrices,
+                                   aliceVision::Vec3& triangulatedPoint)
+{
+    assert(imagePoints.cols() > 1);
+    assert(static_cast<size_t>(imagePoints.cols()) == projectionMatrices.size());
+    aliceVision::Vec4 result;
+    aliceVision::TriangulateNViewAlgebraic(imagePoints, projectionMatrices, &result);
+    triangulatedPoint = result.head<3>();
+    if(result(3) == 0.0)
+        return false;
+    triangulatedPoint /= result(3);
+    return true;
+}
+
+/**
+ * Winding number test for a point in a polygon.
+ *
+ * @param[in] point
+ * @param[in] closedPolygon : vertices of the polygon, with the first vertex repeated at the end
+ * @return the winding number (=0 only when point is outside)
+ */
+int MVGGeometry::windingNumber(const aliceVision::Vec2& point,
+                               const aliceVision::Mat2X& closedPolygon)
+{
+    int wn = 0;
+    for(int i = 0; i < closedPolygon.cols() - 1; i++)
+    {
+        const aliceVision::Vec2 V0 = closedPolygon.col(i);
+        const aliceVision::Vec2 V1 = closedPolygon.col(i + 1);
+        if(V0(1) <= point(1))
+        {
+            if(V1(1) > point(1))
+                if(isLeft(V0, V1, point) > 0)
+                    ++wn;
+        }
+        else
+        {
+            if(V1(1) <= point(1))
+                if(isLeft(V0, V1, point) < 0)
+                    --wn;
+        }
+    }
+    return wn;
+}
+
+/**
+ * Winding number test of many points in a polygon.
+ * Each polygon edge is tested against all points at once to benefit from Eigen vectorization.
+ *
+ * @param[in] points : points to test (one point per column)
+ * @param[in] closedPolygon : vertices of the polygon, with the first vertex repeated at the end
+ * @param[out] pointWindingNumbers : winding number of each point (=0 only when point is outside)
+ */
+void MVGGeometry::windingNumbers(const aliceVision::Mat2X& points,
+                                 const aliceVision::Mat2X& closedPolygon,
+                                 Eigen::ArrayXi& pointWindingNumbers)
+{
+    typedef Eigen::Array<double, Eigen::Dynamic, 1> Array;
+    pointWindingNumbers.setZero(points.cols());
+    if(points.cols() == 0)
+        return;
+    const Array x = points.row(0).transpose().array();
+    const Array y = points.row(1).transpose().array();
+    for(int i = 0; i < closedPolygon.cols() - 1; i++)
+    {
+        const aliceVision::Vec2 V0 = closedPolygon.col(i);
+        const aliceVision::Vec2 V1 = closedPolygon.col(i + 1);
+        // isLeft of each point regarding the edge
+        const Array left = (V1(0) - V0(0)) * (y - V0(1)) - (x - V0(0)) * (V1(1) - V0(1));
+        // upward crossing with point strictly left, downward crossing with point strictly right
+        const Eigen::ArrayXi upward = ((y >= V0(1)) && (y < V1(1)) && (left > 0.0)).cast<int>();
+        const Eigen::ArrayXi downward = ((y < V0(1)) && (y >= V1(1)) && (left < 0.0)).cast<int>();
+        pointWindingNumbers += upward - downward;
+    }
+}
+
+} // namespace
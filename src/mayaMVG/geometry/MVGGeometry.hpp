@@ -0,0 +1,80 @@
+#pragma once
+
+#include "mayaMVG/core/MVGEigen.hpp"
+#include "mayaMVG/geometry/MVGPlaneKernel.hpp"
+#include "mayaMVG/geometry/MVGLineConstrainedPlaneKernel.hpp"
+#include "mayaMVG/geometry/MVGPlaneEstimator.hpp"
+
+#include <vector>
+
+namespace mayaMVG
+{
+
+/**
+ * View and camera parameters used to project points from world space to camera space.
+ * Captured once from a view, so that many points can be projected without querying Maya.
+ */
+struct MVGViewProjection
+{
+    MVGViewProjection();
+    bool operator==(const MVGViewProjection& other) const;
+    bool operator!=(const MVGViewProjection& other) const { return !(*this == other); }
+    double worldToClip[4][4]; // modelViewMatrix * projectionMatrix (row vector convention)
+    double viewportWidth;
+    double viewportHeight;
+    double portWidth;
+    double portHeight;
+    double filmScale; // horizontalFilmAperture * zoom
+    double horizontalPan;
+    double verticalPan;
+};
+
+/**
+ * Geometry routines relying on aliceVision/Eigen types only.
+ * They do not depend on Maya, see MVGGeometryUtil for the Maya adapters.
+ */
+struct MVGGeometry
+{
+    // space conversion
+    static void worldToViewSpace(const MVGViewProjection& projection,
+                                 const aliceVision::Vec3& worldPoint,
+                                 aliceVision::Vec2& viewPoint);
+    static void worldToViewSpace(const MVGViewProjection& projection,
+                                 const aliceVision::Mat3X& worldPoints,
+                                 aliceVision::Mat2X& viewPoints);
+    static void viewToCameraSpace(const MVGViewProjection& projection,
+                                  const aliceVision::Vec2& viewPoint,
+                                  aliceVision::Vec2& cameraPoint);
+    static void worldToCameraSpace(const MVGViewProjection& projection,
+                                   const aliceVision::Mat3X& worldPoints, std::vector<double>& xs,
+                                   std::vector<double>& ys);
+    static void cameraToImageSpace(const double horizontalFilmAperture, const double imageWidth,
+                                   const double imageHeight, const aliceVision::Vec2& cameraPoint,
+                                   aliceVision::Vec2& imagePoint);
+
+    // projections
+    static bool computePlane(const aliceVision::Mat& points, PlaneKernel::Model& model,
+                             const MVGPlaneEstimatorOptions& options = MVGPlaneEstimatorOptions());
+    static bool computePlaneWithLineConstraint(const aliceVision::Mat& points,
+                                               const aliceVision::Vec3& constraintP0,
+                                               const aliceVision::Vec3& constraintP1,
+                                               LineConstrainedPlaneKernel::Model& model,
+                                               const MVGPlaneEstimatorOptions& options =
+                                                   MVGPlaneEstimatorOptions());
+
+    // triangulation
+    static void computeProjectionMatrix(const aliceVision::Mat3& K, const aliceVision::Mat3& R,
+                                        const aliceVision::Vec3& C, aliceVision::Mat34& P);
+    static bool triangulatePoint(const aliceVision::Mat2X& imagePoints,
+                                 const std::vector<aliceVision::Mat34>& projectionMatrices,
+                                 aliceVision::Vec3& triangulatedPoint);
+
+    // polygons
+    static int windingNumber(const aliceVision::Vec2& point,
+                             const aliceVision::Mat2X& closedPolygon);
+    static void windingNumbers(const aliceVision::Mat2X& points,
+                               const aliceVision::Mat2X& closedPolygon,
+                               Eigen::ArrayXi& pointWindingNumbers);
+};
+
+} // namespace
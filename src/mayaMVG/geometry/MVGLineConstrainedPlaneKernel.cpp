@@ -1,4 +1,4 @@
-#include "MVGLineConstrainedPlaneKernel.hpp"
+#include "mayaMVG/geometry/MVGLineConstrainedPlaneKernel.hpp"
 
 #include <aliceVision/robustEstimation/leastMedianOfSquares.hpp>
 
@@ -42,4 +42,34 @@ void LineConstrainedPlaneKernel::Fit(const std::vector<size_t>& samples, std::ve
     equation->push_back(m);
 }
 
+/**
+ * Least squares plane through the samples, containing the constraint line: the normal is
+ * searched in the plane orthogonal to the line. The orientation of the given equation is kept.
+ */
+void LineConstrainedPlaneKernel::Refine(const std::vector<size_t>& samples,
+                                        Model* equation) const
+{
+    if(samples.size() < MINIMUM_SAMPLES || _P1P0.squaredNorm() == 0.0)
+        return;
+    // (u, v): basis of the plane orthogonal to the line
+    const aliceVision::Vec3 direction = _P1P0.normalized();
+    const aliceVision::Vec3 u = direction.unitOrthogonal();
+    const aliceVision::Vec3 v = direction.cross(u);
+    Eigen::Matrix2d scatter = Eigen::Matrix2d::Zero();
+    for(size_t i = 0; i < samples.size(); ++i)
+    {
+        const aliceVision::Vec3 p2p0 = _pt.col(samples[i]) - _constraintP0;
+        const aliceVision::Vec2 uv(p2p0.dot(u), p2p0.dot(v));
+        scatter += uv * uv.transpose();
+    }
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> solver(scatter);
+    if(solver.info() != Eigen::Success)
+        return;
+    const aliceVision::Vec2 uvNormal = solver.eigenvectors().col(0);
+    aliceVision::Vec3 normal = (uvNormal(0) * u + uvNormal(1) * v).normalized();
+    if(normal.dot(equation->head<3>()) < 0.0)
+        normal = -normal;
+    (*equation) << normal, -normal.dot(_constraintP0);
+}
+
 } // namespace
@@ -1,7 +1,6 @@
 #pragma once
 
-#include "MVGEigen.hpp"
-#include <maya/MPoint.h>
+#include "mayaMVG/core/MVGEigen.hpp"
 
 namespace mayaMVG
 {
@@ -18,6 +17,7 @@ struct LineConstrainedPlaneKernel
                                const aliceVision::Vec3& constraintP1);
     size_t NumSamples() const { return _pt.cols(); }
     void Fit(const std::vector<size_t>& samples, std::vector<Model>* equation) const;
+    void Refine(const std::vector<size_t>& samples, Model* equation) const;
     inline double Error(size_t sample, const Model& model) const
     {
         // Calculate the distance from the point to the plane normal as the dot
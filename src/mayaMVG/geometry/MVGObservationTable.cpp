@@ -0,0 +1,176 @@
+#include "mayaMVG/geometry/MVGObservationTable.hpp"
+#include <algorithm>
+
+namespace mayaMVG
+{
+
+namespace
+{ // empty namespace
+
+bool observationLess(const MVGObservationTable::Observation& a,
+                     const MVGObservationTable::Observation& b)
+{
+    if(a.vertexId != b.vertexId)
+        return a.vertexId < b.vertexId;
+    return a.cameraId < b.cameraId;
+}
+
+bool observationEqual(const MVGObservationTable::Observation& a,
+                      const MVGObservationTable::Observation& b)
+{
+    return a.vertexId == b.vertexId && a.cameraId == b.cameraId;
+}
+
+MVGObservationTable::Observation makeObservation(const int vertexId, const int cameraId,
+                                                 const double x = 0.0, const double y = 0.0)
+{
+    MVGObservationTable::Observation observation;
+    observation.vertexId = vertexId;
+    observation.cameraId = cameraId;
+    observation.x = x;
+    observation.y = y;
+    return observation;
+}
+
+} // empty namespace
+
+const int MVGObservationTable::_PACKED_SIZE;
+
+/**
+ * @param[in] vertexId
+ * @param[out] observations : first observation of the vertex, sorted by camera id
+ * @return the number of observations of the vertex
+ */
+int MVGObservationTable::getObservations(const int vertexId,
+                                         const Observation*& observations) const
+{
+    std::vector<Observation>::const_iterator first = std::lower_bound(
+        _observations.begin(), _observations.end(), makeObservation(vertexId, -1), observationLess);
+    std::vector<Observation>::const_iterator last = first;
+    while(last != _observations.end() && last->vertexId == vertexId)
+        ++last;
+    observations = (first == last) ? NULL : &*first;
+    return static_cast<int>(last - first);
+}
+
+bool MVGObservationTable::getObservation(const int vertexId, const int cameraId, double& x,
+                                         double& y) const
+{
+    const Observation key = makeObservation(vertexId, cameraId);
+    std::vector<Observation>::const_iterator it =
+        std::lower_bound(_observations.begin(), _observations.end(), key, observationLess);
+    if(it == _observations.end() || !observationEqual(*it, key))
+        return false;
+    x = it->x;
+    y = it->y;
+    return true;
+}
+
+void MVGObservationTable::setObservation(const int vertexId, const int cameraId, const double x,
+                                         const double y)
+{
+    const Observation observation = makeObservation(vertexId, cameraId, x, y);
+    std::vector<Observation>::iterator it = std::lower_bound(
+        _observations.begin(), _observations.end(), observation, observationLess);
+    if(it != _observations.end() && observationEqual(*it, observation))
+        *it = observation;
+    else
+        _observations.insert(it, observation);
+}
+
+/**
+ * Add or replace observations. When the same (vertex, camera) pair is given several times, the
+ * last one is kept.
+ */
+void MVGObservationTable::setObservations(const std::vector<Observation>& observations)
+{
+    if(observations.empty())
+        return;
+    std::vector<Observation> edits(observations.rbegin(), observations.rend());
+    std::stable_sort(edits.begin(), edits.end(), observationLess);
+    edits.erase(std::unique(edits.begin(), edits.end(), observationEqual), edits.end());
+
+    // Merge, edits taking precedence over existing observations
+    std::vector<Observation> merged;
+    merged.reserve(_observations.size() + edits.size());
+    std::vector<Observation>::const_iterator it = _observations.begin();
+    std::vector<Observation>::const_iterator editIt = edits.begin();
+    while(it != _observations.end() || editIt != edits.end())
+    {
+        if(editIt == edits.end() || (it != _observations.end() && observationLess(*it, *editIt)))
+        {
+            merged.push_back(*it++);
+            continue;
+        }
+        if(it != _observations.end() && observationEqual(*it, *editIt))
+            ++it;
+        merged.push_back(*editIt++);
+    }
+    _observations.swap(merged);
+}
+
+void MVGObservationTable::unsetObservation(const int vertexId, const int cameraId)
+{
+    const Observation key = makeObservation(vertexId, cameraId);
+    std::vector<Observation>::iterator it =
+        std::lower_bound(_observations.begin(), _observations.end(), key, observationLess);
+    if(it != _observations.end() && observationEqual(*it, key))
+        _observations.erase(it);
+}
+
+/**
+ * Remove all observations of the given vertices.
+ */
+void MVGObservationTable::unsetObservations(const std::vector<int>& vertexIds)
+{
+    if(vertexIds.empty() || _observations.empty())
+        return;
+    std::vector<int> sortedIds(vertexIds);
+    std::sort(sortedIds.begin(), sortedIds.end());
+    std::vector<Observation>::iterator last = _observations.begin();
+    for(std::vector<Observation>::const_iterator it = _observations.begin();
+        it != _observations.end(); ++it)
+    {
+        if(!std::binary_search(sortedIds.begin(), sortedIds.end(), it->vertexId))
+            *last++ = *it;
+    }
+    _observations.erase(last, _observations.end());
+}
+
+/**
+ * @param[out] packed : _PACKED_SIZE doubles (vertex id, camera id, x, y) per observation
+ */
+void MVGObservationTable::pack(std::vector<double>& packed) const
+{
+    packed.resize(_observations.size() * _PACKED_SIZE);
+    for(size_t i = 0; i < _observations.size(); ++i)
+    {
+        const Observation& observation = _observations[i];
+        packed[i * _PACKED_SIZE] = observation.vertexId;
+        packed[i * _PACKED_SIZE + 1] = observation.cameraId;
+        packed[i * _PACKED_SIZE + 2] = observation.x;
+        packed[i * _PACKED_SIZE + 3] = observation.y;
+    }
+}
+
+/**
+ * @param[in] packed : as written by pack
+ * @param[in] count : number of doubles
+ */
+void MVGObservationTable::unpack(const double* packed, const int count)
+{
+    _observations.resize(count / _PACKED_SIZE);
+    for(size_t i = 0; i < _observations.size(); ++i)
+    {
+        const double* values = packed + i * _PACKED_SIZE;
+        _observations[i] = makeObservation(static_cast<int>(values[0]),
+                                           static_cast<int>(values[1]), values[2], values[3]);
+    }
+    // Keep the table valid whatever the attribute content
+    if(!std::is_sorted(_observations.begin(), _observations.end(), observationLess))
+        std::stable_sort(_observations.begin(), _observations.end(), observationLess);
+    _observations.erase(std::unique(_observations.begin(), _observations.end(), observationEqual),
+                        _observations.end());
+}
+
+} // namespace
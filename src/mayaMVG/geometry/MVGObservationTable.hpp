@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+namespace mayaMVG
+{
+
+/**
+ * 2D observations (clicked camera space positions) of mesh vertices, stored as a single table of
+ * (vertex, camera, x, y) records sorted by vertex then camera.
+ * Per-vertex access is a binary search; bulk edits sort the edited records once and merge them.
+ */
+class MVGObservationTable
+{
+public:
+    struct Observation
+    {
+        int vertexId;
+        int cameraId;
+        double x;
+        double y;
+    };
+    static const int _PACKED_SIZE = 4; // number of doubles per packed observation
+
+public:
+    void clear() { _observations.clear(); }
+    bool isEmpty() const { return _observations.empty(); }
+    int size() const { return static_cast<int>(_observations.size()); }
+    const Observation& operator[](const int index) const { return _observations[index]; }
+
+    int getObservations(const int vertexId, const Observation*& observations) const;
+    bool getObservation(const int vertexId, const int cameraId, double& x, double& y) const;
+
+    void setObservation(const int vertexId, const int cameraId, const double x, const double y);
+    void setObservations(const std::vector<Observation>& observations);
+    void unsetObservation(const int vertexId, const int cameraId);
+    void unsetObservations(const std::vector<int>& vertexIds);
+
+    void pack(std::vector<double>& packed) const;
+    void unpack(const double* packed, const int count);
+
+private:
+    std::vector<Observation> _observations;
+};
+
+} // namespace
@@ -0,0 +1,114 @@
+#include "mayaMVG/geometry/MVGPlaneEstimator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mayaMVG
+{
+
+MVGPlaneEstimatorOptions::MVGPlaneEstimatorOptions()
+    : method(kLMedS)
+    , threshold(0.0)
+    , relativeThreshold(0.01)
+    , confidence(0.99)
+    , maxIterations(1000)
+    , maxScoredPoints(2000)
+    , refine(true)
+    , seed(42)
+{
+}
+
+/**
+ * @param[in] name : "lmeds", "ransac" or "msac"
+ * @param[out] method
+ * @return false if the name is unknown
+ */
+bool MVGPlaneEstimatorOptions::stringToMethod(const std::string& name, EMethod& method)
+{
+    if(name == "lmeds")
+        method = kLMedS;
+    else if(name == "ransac")
+        method = kRansac;
+    else if(name == "msac")
+        method = kMsac;
+    else
+        return false;
+    return true;
+}
+
+MVGPlaneEstimator::MVGPlaneEstimator(const MVGPlaneEstimatorOptions& options)
+    : _options(options)
+    , _generator(options.seed)
+{
+}
+
+/**
+ * Number of samples to draw so that at least one of them is outlier free, with the given
+ * probability.
+ * @param[in] inlierRatio : ratio of inliers of the best hypothesis
+ * @param[in] sampleSize : points per sample
+ * @param[in] confidence
+ * @param[in] maxIterations : upper bound of the result
+ */
+int MVGPlaneEstimator::requiredIterations(const double inlierRatio, const int sampleSize,
+                                          const double confidence, const int maxIterations)
+{
+    const double outlierFreeProbability = std::pow(inlierRatio, sampleSize);
+    if(outlierFreeProbability >= 1.0)
+        return 1;
+    if(outlierFreeProbability <= 0.0)
+        return maxIterations;
+    const double iterations =
+        std::ceil(std::log(1.0 - confidence) / std::log1p(-outlierFreeProbability));
+    if(!(iterations < maxIterations)) // also handles NaN
+        return maxIterations;
+    return std::max(1, static_cast<int>(iterations));
+}
+
+double MVGPlaneEstimator::getThreshold(const aliceVision::Mat& points) const
+{
+    if(_options.threshold > 0.0)
+        return _options.threshold;
+    if(points.cols() == 0)
+        return 0.0;
+    const aliceVision::Vec diagonal = points.rowwise().maxCoeff() - points.rowwise().minCoeff();
+    return _options.relativeThreshold * diagonal.norm();
+}
+
+/**
+ * Draw sampleSize distinct indexes in [0, populationSize).
+ */
+void MVGPlaneEstimator::drawSamples(const size_t sampleSize, const size_t populationSize,
+                                    std::vector<size_t>& samples)
+{
+    samples.clear();
+    if(sampleSize >= populationSize)
+    {
+        for(size_t i = 0; i < populationSize; ++i)
+            samples.push_back(i);
+        return;
+    }
+    // Floyd's algorithm: sampleSize draws, without shuffling the whole population
+    const bool useMarkers = sampleSize > 16;
+    std::vector<bool> isDrawn;
+    if(useMarkers)
+        isDrawn.assign(populationSize, false);
+    for(size_t j = populationSize - sampleSize; j < populationSize; ++j)
+    {
+        std::uniform_int_distribution<size_t> distribution(0, j);
+        size_t index = distribution(_generator);
+        const bool alreadyDrawn = useMarkers ? isDrawn[index]
+                                             : std::find(samples.begin(), samples.end(),
+                                                         index) != samples.end();
+        if(alreadyDrawn)
+            index = j;
+        samples.push_back(index);
+        if(useMarkers)
+            isDrawn[index] = true;
+    }
+    // better memory locality when browsing the points
+    if(useMarkers)
+        std::sort(samples.begin(), samples.end());
+}
+
+} // namespace
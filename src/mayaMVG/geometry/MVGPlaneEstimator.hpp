@@ -0,0 +1,162 @@
+#pragma once
+
+#include "mayaMVG/core/MVGEigen.hpp"
+
+#include <aliceVision/robustEstimation/leastMedianOfSquares.hpp>
+
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace mayaMVG
+{
+
+struct MVGPlaneEstimatorOptions
+{
+    enum EMethod
+    {
+        kLMedS = 0, // aliceVision LeastMedianOfSquares, no threshold needed
+        kRansac,    // inlier count
+        kMsac       // truncated quadratic cost
+    };
+
+    MVGPlaneEstimatorOptions();
+    static bool stringToMethod(const std::string& name, EMethod& method);
+
+    EMethod method;
+    double threshold;         // inlier distance, <= 0 to use relativeThreshold
+    double relativeThreshold; // inlier distance as a fraction of the points bounding box diagonal
+    double confidence;        // probability to draw at least one outlier free sample
+    int maxIterations;
+    int maxScoredPoints;      // points used to score the hypotheses, <= 0 to use all of them
+    bool refine;              // least squares fit on the inliers of the best hypothesis
+    unsigned int seed;        // same seed, same result
+};
+
+/**
+ * Robust plane fitting on the kernels of MVGPlaneKernel.hpp and
+ * MVGLineConstrainedPlaneKernel.hpp.
+ * RANSAC and MSAC stop as soon as enough samples have been drawn to reach the requested
+ * confidence, given the best inlier ratio found so far. Large inputs are scored on a random
+ * subset of the points; the inliers used by the refinement are taken from all of them.
+ */
+class MVGPlaneEstimator
+{
+public:
+    explicit MVGPlaneEstimator(
+        const MVGPlaneEstimatorOptions& options = MVGPlaneEstimatorOptions());
+
+public:
+    template <typename Kernel>
+    bool estimate(const Kernel& kernel, typename Kernel::Model& model,
+                  std::vector<size_t>* inliers = NULL);
+
+    static int requiredIterations(const double inlierRatio, const int sampleSize,
+                                  const double confidence, const int maxIterations);
+
+private:
+    double getThreshold(const aliceVision::Mat& points) const;
+    void drawSamples(const size_t sampleSize, const size_t populationSize,
+                     std::vector<size_t>& samples);
+
+private:
+    MVGPlaneEstimatorOptions _options;
+    std::mt19937 _generator;
+};
+
+/**
+ * @param[in] kernel : PlaneKernel or LineConstrainedPlaneKernel
+ * @param[out] model : best plane
+ * @param[out] inliers : optional, indexes of the points closer than the threshold (RANSAC/MSAC)
+ * @return false if there are not enough points or all samples are degenerate
+ */
+template <typename Kernel>
+bool MVGPlaneEstimator::estimate(const Kernel& kernel, typename Kernel::Model& model,
+                                 std::vector<size_t>* inliers)
+{
+    const size_t pointCount = kernel.NumSamples();
+    if(pointCount < static_cast<size_t>(Kernel::MINIMUM_SAMPLES))
+        return false;
+
+    if(_options.method == MVGPlaneEstimatorOptions::kLMedS)
+    {
+        double outlierThreshold = std::numeric_limits<double>::infinity();
+        aliceVision::robustEstimation::LeastMedianOfSquares(kernel, &model, &outlierThreshold);
+        return true;
+    }
+
+    const double threshold = getThreshold(kernel._pt);
+    const double squaredThreshold = threshold * threshold;
+    const bool msac = (_options.method == MVGPlaneEstimatorOptions::kMsac);
+
+    std::vector<size_t> scoredPoints;
+    if(_options.maxScoredPoints > 0 && pointCount > static_cast<size_t>(_options.maxScoredPoints))
+        drawSamples(_options.maxScoredPoints, pointCount, scoredPoints);
+    else
+    {
+        scoredPoints.resize(pointCount);
+        for(size_t i = 0; i < pointCount; ++i)
+            scoredPoints[i] = i;
+    }
+
+    // RANSAC cost: squaredThreshold per outlier, MSAC cost: truncated squared error
+    double bestCost = std::numeric_limits<double>::infinity();
+    bool found = false;
+    int iterationCount = _options.maxIterations;
+    std::vector<size_t> sample;
+    std::vector<typename Kernel::Model> models;
+    for(int iteration = 0; iteration < iterationCount; ++iteration)
+    {
+        drawSamples(Kernel::MINIMUM_SAMPLES, pointCount, sample);
+        kernel.Fit(sample, &models);
+        for(size_t m = 0; m < models.size(); ++m)
+        {
+            double cost = 0.0;
+            size_t inlierCount = 0;
+            size_t i = 0;
+            for(; i < scoredPoints.size() && cost < bestCost; ++i)
+            {
+                const double error = kernel.Error(scoredPoints[i], models[m]);
+                const double squaredError = error * error;
+                if(squaredError < squaredThreshold)
+                {
+                    ++inlierCount;
+                    if(msac)
+                        cost += squaredError;
+                }
+                else
+                    cost += squaredThreshold;
+            }
+            // early exit: partially scored hypotheses are already worse than the best one
+            if(i < scoredPoints.size() || cost >= bestCost)
+                continue;
+            bestCost = cost;
+            model = models[m];
+            found = true;
+            iterationCount = requiredIterations(
+                static_cast<double>(inlierCount) / scoredPoints.size(), Kernel::MINIMUM_SAMPLES,
+                _options.confidence, _options.maxIterations);
+        }
+    }
+    if(!found)
+        return false;
+
+    // all points, distances to the plane computed at once
+    const Eigen::ArrayXd distances =
+        ((model.template head<3>().transpose() * kernel._pt).array() + model(3)).abs().transpose();
+    std::vector<size_t> bestInliers;
+    bestInliers.reserve(pointCount);
+    for(size_t i = 0; i < pointCount; ++i)
+    {
+        if(distances(i) < threshold)
+            bestInliers.push_back(i);
+    }
+    if(_options.refine)
+        kernel.Refine(bestInliers, &model);
+    if(inliers)
+        inliers->swap(bestInliers);
+    return true;
+}
+
+} // namespace
@@ -1,7 +1,6 @@
 #pragma once
 
-#include "MVGEigen.hpp"
-#include <maya/MPoint.h>
+#include "mayaMVG/core/MVGEigen.hpp"
 
 namespace mayaMVG {
 
@@ -20,6 +19,7 @@ struct PlaneKernel
     size_t NumSamples() const { return _pt.cols(); }
     
     void Fit(const std::vector<size_t>& samples, std::vector<Model>* equation) const;
+    void Refine(const std::vector<size_t>& samples, Model* equation) const;
     
     inline double Error(size_t sample, const Model& model) const
     {
@@ -34,11 +34,11 @@ struct PlaneKernel
 };
 
 // FIXME check return value
-inline bool plane_line_intersect(const PlaneKernel::Model& model, const MPoint& P1,
-                                 const MPoint& P2, MPoint& P)
+inline bool plane_line_intersect(const PlaneKernel::Model& model, const aliceVision::Vec3& P1,
+                                 const aliceVision::Vec3& P2, aliceVision::Vec3& P)
 {
-    double u = (model(0) * P1.x + model(1) * P1.y + model(2) * P1.z + model(3)) /
-               (model(0) * (P1.x - P2.x) + model(1) * (P1.y - P2.y) + model(2) * (P1.z - P2.z));
+    double u = model.head<3>().dot(P1) + model(3);
+    u /= model.head<3>().dot(P1 - P2);
     P = P1 + u * (P2 - P1);
     return (0 < u && u < 1);
 }
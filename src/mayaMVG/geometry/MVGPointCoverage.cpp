@@ -0,0 +1,60 @@
+#include "mayaMVG/geometry/MVGPointCoverage.hpp"
+#include "mayaMVG/geometry/MVGVisibilityIndex.hpp"
+#include <cstddef>
+
+namespace mayaMVG
+{
+
+MVGPointCoverage::MVGPointCoverage()
+{
+}
+
+void MVGPointCoverage::clear()
+{
+    _coveragePerPoint.clear();
+    _isActivePerSlot.clear();
+}
+
+/**
+ * Update point coverage with the cameras entering or leaving the active set.
+ *
+ * @param[in] visibility : visibility index, must be the same between two calls unless
+ * clear() is called in between
+ * @param[in] slots : camera slots of the active cameras (negative slots are ignored)
+ */
+void MVGPointCoverage::setActiveCameras(const MVGVisibilityIndex& visibility,
+                                        const std::vector<int>& slots)
+{
+    const size_t pointCount = visibility.getPointCount();
+    const size_t cameraCount = visibility.getCameraCount();
+    if(_coveragePerPoint.size() != pointCount || _isActivePerSlot.size() != cameraCount)
+    {
+        _coveragePerPoint.assign(pointCount, 0);
+        _isActivePerSlot.assign(cameraCount, 0);
+    }
+
+    std::vector<char> isActivePerSlot(cameraCount, 0);
+    for(size_t i = 0; i < slots.size(); ++i)
+    {
+        if(slots[i] >= 0 && slots[i] < static_cast<int>(cameraCount))
+            isActivePerSlot[slots[i]] = 1;
+    }
+    for(size_t slot = 0; slot < cameraCount; ++slot)
+    {
+        if(isActivePerSlot[slot] == _isActivePerSlot[slot])
+            continue;
+        updateCamera(visibility, static_cast<int>(slot), isActivePerSlot[slot] ? 1 : -1);
+    }
+    _isActivePerSlot.swap(isActivePerSlot);
+}
+
+void MVGPointCoverage::updateCamera(const MVGVisibilityIndex& visibility, const int slot,
+                                    const int delta)
+{
+    const int* points = NULL;
+    const int count = visibility.getPoints(slot, points);
+    for(int i = 0; i < count; ++i)
+        _coveragePerPoint[points[i]] += delta;
+}
+
+} // namespace
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+namespace mayaMVG
+{
+
+class MVGVisibilityIndex;
+
+/**
+ * Number of active cameras seeing each point of a visibility index.
+ * Counts are updated by delta when cameras are activated or deactivated, so that only the
+ * points of these cameras are browsed.
+ */
+class MVGPointCoverage
+{
+public:
+    MVGPointCoverage();
+
+public:
+    void clear();
+    void setActiveCameras(const MVGVisibilityIndex& visibility, const std::vector<int>& slots);
+    const std::vector<int>& getCoveragePerPoint() const { return _coveragePerPoint; }
+
+private:
+    void updateCamera(const MVGVisibilityIndex& visibility, const int slot, const int delta);
+
+private:
+    std::vector<int> _coveragePerPoint;
+    std::vector<char> _isActivePerSlot;
+};
+
+} // namespace
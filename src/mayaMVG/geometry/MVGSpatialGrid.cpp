@@ -0,0 +1,179 @@
+#include "mayaMVG/geometry/MVGSpatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace mayaMVG
+{
+
+namespace
+{ // empty namespace
+
+// Grid resolution limits (per axis)
+const int kMaxCellsPerAxis = 1024;
+// Items covering more cells than this are stored apart and always returned by queries
+const int kMaxCellsPerItem = 64;
+
+} // empty namespace
+
+MVGSpatialGrid::MVGSpatialGrid()
+    : _minX(0.0)
+    , _minY(0.0)
+    , _cellWidth(1.0)
+    , _cellHeight(1.0)
+    , _width(0)
+    , _height(0)
+{
+}
+
+/**
+ * Clear the grid and set its bounds and resolution.
+ * The resolution is chosen to get roughly one item per cell.
+ *
+ * @param[in] minX, minY, maxX, maxY bounds of the grid
+ * @param[in] itemCount expected number of items
+ */
+void MVGSpatialGrid::reset(const double minX, const double minY, const double maxX,
+                           const double maxY, const int itemCount)
+{
+    clear();
+    const int cellsPerAxis =
+        static_cast<int>(std::ceil(std::sqrt(std::max(1.0, (double)itemCount))));
+    _width = std::min(cellsPerAxis, kMaxCellsPerAxis);
+    _height = _width;
+    _minX = minX;
+    _minY = minY;
+    _cellWidth = (maxX > minX) ? (maxX - minX) / _width : 1.0;
+    _cellHeight = (maxY > minY) ? (maxY - minY) / _height : 1.0;
+    _cells.resize(_width * _height);
+}
+
+void MVGSpatialGrid::clear()
+{
+    _width = 0;
+    _height = 0;
+    _cells.clear();
+    _itemRanges.clear();
+    _largeItems.clear();
+}
+
+void MVGSpatialGrid::insert(const int id, const double minX, const double minY, const double maxX,
+                            const double maxY)
+{
+    if(isEmpty() || id < 0)
+        return;
+    if(id >= static_cast<int>(_itemRanges.size()))
+        _itemRanges.resize(id + 1);
+    else if(_itemRanges[id].isValid())
+        remove(id);
+
+    CellRange range = cellRange(minX, minY, maxX, maxY);
+    if((range.x1 - range.x0 + 1) * (range.y1 - range.y0 + 1) > kMaxCellsPerItem)
+    {
+        range.large = true;
+        _largeItems.push_back(id);
+    }
+    else
+    {
+        for(int y = range.y0; y <= range.y1; ++y)
+            for(int x = range.x0; x <= range.x1; ++x)
+                _cells[y * _width + x].push_back(id);
+    }
+    _itemRanges[id] = range;
+}
+
+void MVGSpatialGrid::remove(const int id)
+{
+    if(id < 0 || id >= static_cast<int>(_itemRanges.size()) || !_itemRanges[id].isValid())
+        return;
+    const CellRange& range = _itemRanges[id];
+    if(range.large)
+    {
+        _largeItems.erase(std::remove(_largeItems.begin(), _largeItems.end(), id),
+                          _largeItems.end());
+    }
+    else
+    {
+        for(int y = range.y0; y <= range.y1; ++y)
+        {
+            for(int x = range.x0; x <= range.x1; ++x)
+            {
+                std::vector<int>& cell = _cells[y * _width + x];
+                cell.erase(std::remove(cell.begin(), cell.end(), id), cell.end());
+            }
+        }
+    }
+    _itemRanges[id] = CellRange();
+}
+
+void MVGSpatialGrid::move(const int id, const double minX, const double minY, const double maxX,
+                          const double maxY)
+{
+    if(isEmpty() || id < 0)
+        return;
+    if(id < static_cast<int>(_itemRanges.size()) && _itemRanges[id].isValid())
+    {
+        const CellRange& oldRange = _itemRanges[id];
+        const CellRange newRange = cellRange(minX, minY, maxX, maxY);
+        // Nothing to do if the item stays in the same cells
+        if(!oldRange.large && oldRange.x0 == newRange.x0 && oldRange.y0 == newRange.y0 &&
+           oldRange.x1 == newRange.x1 && oldRange.y1 == newRange.y1)
+            return;
+    }
+    insert(id, minX, minY, maxX, maxY);
+}
+
+/**
+ * Retrieve the ids of the items whose bounding box may overlap the given box.
+ * Returned ids are sorted and unique. Candidates must be checked by the caller.
+ *
+ * @param[in] minX, minY, maxX, maxY query box
+ * @param[out] ids candidate item ids
+ */
+void MVGSpatialGrid::query(const double minX, const double minY, const double maxX,
+                           const double maxY, std::vector<int>& ids) const
+{
+    ids.clear();
+    if(isEmpty())
+        return;
+    const CellRange range = cellRange(minX, minY, maxX, maxY);
+    for(int y = range.y0; y <= range.y1; ++y)
+    {
+        for(int x = range.x0; x <= range.x1; ++x)
+        {
+            const std::vector<int>& cell = _cells[y * _width + x];
+            ids.insert(ids.end(), cell.begin(), cell.end());
+        }
+    }
+    ids.insert(ids.end(), _largeItems.begin(), _largeItems.end());
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+int MVGSpatialGrid::cellX(const double x) const
+{
+    const double cell = std::floor((x - _minX) / _cellWidth);
+    if(!(cell > 0.0)) // also handles NaN
+        return 0;
+    return (cell >= _width) ? _width - 1 : static_cast<int>(cell);
+}
+
+int MVGSpatialGrid::cellY(const double y) const
+{
+    const double cell = std::floor((y - _minY) / _cellHeight);
+    if(!(cell > 0.0))
+        return 0;
+    return (cell >= _height) ? _height - 1 : static_cast<int>(cell);
+}
+
+MVGSpatialGrid::CellRange MVGSpatialGrid::cellRange(const double minX, const double minY,
+                                                    const double maxX, const double maxY) const
+{
+    CellRange range;
+    range.x0 = cellX(std::min(minX, maxX));
+    range.x1 = cellX(std::max(minX, maxX));
+    range.y0 = cellY(std::min(minY, maxY));
+    range.y1 = cellY(std::max(minY, maxY));
+    return range;
+}
+
+} // namespace
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+
+namespace mayaMVG
+{
+
+/**
+ * Uniform 2D grid used to accelerate proximity queries (picking) on 2D items.
+ * Items are identified by non-negative integer ids (typically vertex or edge indices) and
+ * registered by their bounding box. Coordinates outside of the grid bounds are clamped to
+ * the border cells, so items can be moved without rebuilding the whole grid.
+ */
+class MVGSpatialGrid
+{
+public:
+    MVGSpatialGrid();
+
+public:
+    void reset(const double minX, const double minY, const double maxX, const double maxY,
+               const int itemCount);
+    void clear();
+    bool isEmpty() const { return _cells.empty(); }
+
+    void insert(const int id, const double minX, const double minY, const double maxX,
+                const double maxY);
+    void insert(const int id, const double x, const double y) { insert(id, x, y, x, y); }
+    void remove(const int id);
+    void move(const int id, const double minX, const double minY, const double maxX,
+              const double maxY);
+    void move(const int id, const double x, const double y) { move(id, x, y, x, y); }
+
+    void query(const double minX, const double minY, const double maxX, const double maxY,
+               std::vector<int>& ids) const;
+
+private:
+    struct CellRange
+    {
+        CellRange()
+            : x0(-1)
+            , y0(-1)
+            , x1(-1)
+            , y1(-1)
+            , large(false)
+        {
+        }
+        bool isValid() const { return x0 >= 0; }
+        int x0, y0, x1, y1;
+        bool large;
+    };
+
+    int cellX(const double x) const;
+    int cellY(const double y) const;
+    CellRange cellRange(const double minX, const double minY, const double maxX,
+                        const double maxY) const;
+
+private:
+    double _minX;
+    double _minY;
+    double _cellWidth;
+    double _cellHeight;
+    int _width;
+    int _height;
+    std::vector<std::vector<int> > _cells;
+    std::vector<CellRange> _itemRanges; // per item id
+    std::vector<int> _largeItems;       // items spanning too many cells, always tested
+};
+
+} // namespace
@@ -0,0 +1,78 @@
+#include "mayaMVG/geometry/MVGViewPointGrid.hpp"
+
+namespace mayaMVG
+{
+
+MVGViewPointGrid::MVGViewPointGrid()
+    : _isBuilt(false)
+{
+}
+
+void MVGViewPointGrid::clear()
+{
+    _viewPoints.resize(2, 0);
+    _grid.clear();
+    _isBuilt = false;
+}
+
+/**
+ * @return true if the grid has been built with the given projection
+ */
+bool MVGViewPointGrid::isBuilt(const MVGViewProjection& projection) const
+{
+    return _isBuilt && _projection == projection;
+}
+
+/**
+ * @param[in] projection : view parameters retrieved with MVGGeometryUtil::getViewProjection
+ * @param[in] worldPoints : points in world space (one point per column)
+ */
+void MVGViewPointGrid::build(const MVGViewProjection& projection,
+                             const aliceVision::Mat3X& worldPoints)
+{
+    clear();
+    _projection = projection;
+    MVGGeometry::worldToViewSpace(projection, worldPoints, _viewPoints);
+    _isBuilt = true;
+    if(_viewPoints.cols() == 0)
+        return;
+    const aliceVision::Vec2 minPoint = _viewPoints.rowwise().minCoeff();
+    const aliceVision::Vec2 maxPoint = _viewPoints.rowwise().maxCoeff();
+    _grid.reset(minPoint(0), minPoint(1), maxPoint(0), maxPoint(1),
+                static_cast<int>(_viewPoints.cols()));
+    for(int i = 0; i < _viewPoints.cols(); ++i)
+        _grid.insert(i, _viewPoints(0, i), _viewPoints(1, i));
+}
+
+/**
+ * @param[in] closedPolygon : polygon in view space, with the first vertex repeated at the end
+ * @param[out] indexes : sorted indexes (columns of the build points) of the enclosed points
+ */
+void MVGViewPointGrid::getEnclosedPoints(const aliceVision::Mat2X& closedPolygon,
+                                         std::vector<int>& indexes) const
+{
+    indexes.clear();
+    if(closedPolygon.cols() < 4 || _grid.isEmpty())
+        return;
+
+    // Bounding box prefilter
+    const aliceVision::Vec2 minPoint = closedPolygon.rowwise().minCoeff();
+    const aliceVision::Vec2 maxPoint = closedPolygon.rowwise().maxCoeff();
+    std::vector<int> candidates;
+    _grid.query(minPoint(0), minPoint(1), maxPoint(0), maxPoint(1), candidates);
+    if(candidates.empty())
+        return;
+
+    aliceVision::Mat2X candidatePoints(2, candidates.size());
+    for(size_t i = 0; i < candidates.size(); ++i)
+        candidatePoints.col(i) = _viewPoints.col(candidates[i]);
+    Eigen::ArrayXi windingNumbers;
+    MVGGeometry::windingNumbers(candidatePoints, closedPolygon, windingNumbers);
+    for(size_t i = 0; i < candidates.size(); ++i)
+    {
+        if(windingNumbers(i) != 0)
+            indexes.push_back(candidates[i]);
+    }
+}
+
+} // namespace
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "mayaMVG/geometry/MVGGeometry.hpp"
+#include "mayaMVG/geometry/MVGSpatialGrid.hpp"
+
+#include <vector>
+
+namespace mayaMVG
+{
+
+/**
+ * View space positions of a set of world space points, bucketed in a MVGSpatialGrid to find
+ * the points enclosed by a polygon without testing every point.
+ * Positions are valid for a given view projection, the grid must be built again when the view
+ * changes (see isBuilt).
+ */
+class MVGViewPointGrid
+{
+public:
+    MVGViewPointGrid();
+
+public:
+    void clear();
+    bool isBuilt(const MVGViewProjection& projection) const;
+    void build(const MVGViewProjection& projection, const aliceVision::Mat3X& worldPoints);
+    void getEnclosedPoints(const aliceVision::Mat2X& closedPolygon,
+                           std::vector<int>& indexes) const;
+
+private:
+    MVGViewProjection _projection;
+    aliceVision::Mat2X _viewPoints; // one column per point
+    MVGSpatialGrid _grid;
+    bool _isBuilt;
+};
+
+} // namespace
@@ -0,0 +1,181 @@
+#include "mayaMVG/geometry/MVGVisibilityIndex.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace mayaMVG
+{
+
+MVGVisibilityIndex::MVGVisibilityIndex()
+{
+    clear();
+}
+
+void MVGVisibilityIndex::clear()
+{
+    _pointOffsets.assign(1, 0);
+    _pointCameras.clear();
+    _cameraOffsets.assign(1, 0);
+    _cameraPoints.clear();
+    _viewIds.clear();
+    _slotPerViewId.clear();
+}
+
+/**
+ * Build the index from the point cloud visibility, as exported in the SfM Alembic file.
+ * Camera slots are sorted by view id.
+ *
+ * @param[in] visibilitySizes : number of cameras seeing each point (mvg_visibilitySize)
+ * @param[in] visibilityIds : per point and per observation, the view id followed by
+ * (stride - 1) other values (mvg_visibilityIds)
+ * @param[in] stride : number of values per observation in visibilityIds
+ */
+void MVGVisibilityIndex::buildFromPoints(const std::vector<int>& visibilitySizes,
+                                         const std::vector<int>& visibilityIds, const int stride)
+{
+    clear();
+    const int pointCount = static_cast<int>(visibilitySizes.size());
+    const int observationCount = static_cast<int>(visibilityIds.size()) / stride;
+
+    // Camera slots
+    std::vector<int> viewIds;
+    viewIds.reserve(observationCount);
+    for(int i = 0; i < observationCount; ++i)
+        viewIds.push_back(visibilityIds[i * stride]);
+    std::sort(viewIds.begin(), viewIds.end());
+    viewIds.erase(std::unique(viewIds.begin(), viewIds.end()), viewIds.end());
+    _viewIds = viewIds;
+    for(size_t slot = 0; slot < _viewIds.size(); ++slot)
+        _slotPerViewId[_viewIds[slot]] = static_cast<int>(slot);
+
+    // Point -> cameras
+    _pointOffsets.resize(pointCount + 1);
+    _pointCameras.reserve(observationCount);
+    int observation = 0;
+    for(int pointId = 0; pointId < pointCount; ++pointId)
+    {
+        const int first = static_cast<int>(_pointCameras.size());
+        const int end = std::min(observation + visibilitySizes[pointId], observationCount);
+        for(; observation < end; ++observation)
+        {
+            const int viewId = visibilityIds[observation * stride];
+            _pointCameras.push_back(static_cast<int>(
+                std::lower_bound(_viewIds.begin(), _viewIds.end(), viewId) - _viewIds.begin()));
+        }
+        std::sort(_pointCameras.begin() + first, _pointCameras.end());
+        _pointOffsets[pointId + 1] = static_cast<int>(_pointCameras.size());
+    }
+
+    // Camera -> points
+    transpose(_pointOffsets, _pointCameras, getCameraCount(), _cameraOffsets, _cameraPoints);
+}
+
+/**
+ * Add the visible points of a camera. Call buildFromCameras once all cameras are added.
+ * Camera slots are given in the order of insertion.
+ *
+ * @param[in] viewId
+ * @param[in] points : visible point ids
+ * @param[in] count : number of points
+ */
+void MVGVisibilityIndex::addCamera(const int viewId, const int* points, const int count)
+{
+    if(_slotPerViewId.count(viewId))
+        return;
+    _slotPerViewId[viewId] = getCameraCount();
+    _viewIds.push_back(viewId);
+    const size_t first = _cameraPoints.size();
+    for(int i = 0; i < count; ++i)
+    {
+        if(points[i] >= 0)
+            _cameraPoints.push_back(points[i]);
+    }
+    std::sort(_cameraPoints.begin() + first, _cameraPoints.end());
+    _cameraOffsets.push_back(static_cast<int>(_cameraPoints.size()));
+}
+
+void MVGVisibilityIndex::buildFromCameras()
+{
+    int pointCount = 0;
+    for(size_t i = 0; i < _cameraPoints.size(); ++i)
+        pointCount = std::max(pointCount, _cameraPoints[i] + 1);
+    transpose(_cameraOffsets, _cameraPoints, pointCount, _pointOffsets, _pointCameras);
+}
+
+/**
+ * @return the number of cameras seeing the point
+ */
+int MVGVisibilityIndex::getCameraSlots(const int pointId, const int*& slots) const
+{
+    if(pointId < 0 || pointId >= getPointCount())
+        return 0;
+    slots = _pointCameras.empty() ? NULL : &_pointCameras[0] + _pointOffsets[pointId];
+    return _pointOffsets[pointId + 1] - _pointOffsets[pointId];
+}
+
+/**
+ * @return the number of points seen by the camera
+ */
+int MVGVisibilityIndex::getPoints(const int slot, const int*& points) const
+{
+    if(slot < 0 || slot >= getCameraCount())
+        return 0;
+    points = _cameraPoints.empty() ? NULL : &_cameraPoints[0] + _cameraOffsets[slot];
+    return _cameraOffsets[slot + 1] - _cameraOffsets[slot];
+}
+
+/**
+ * Count, for each camera, how many of the given points it sees.
+ *
+ * @param[in] points : point ids, without duplicates
+ * @param[out] countPerSlot : number of visible points per camera slot
+ */
+void MVGVisibilityIndex::countPointsPerCamera(const std::vector<int>& points,
+                                              std::vector<int>& countPerSlot) const
+{
+    countPerSlot.assign(getCameraCount(), 0);
+    for(size_t i = 0; i < points.size(); ++i)
+    {
+        const int* slots = NULL;
+        const int count = getCameraSlots(points[i], slots);
+        for(int j = 0; j < count; ++j)
+            ++countPerSlot[slots[j]];
+    }
+}
+
+/**
+ * @return the camera slot, or -1 if no camera has this view id
+ */
+int MVGVisibilityIndex::getSlot(const int viewId) const
+{
+    std::map<int, int>::const_iterator it = _slotPerViewId.find(viewId);
+    if(it == _slotPerViewId.end())
+        return -1;
+    return it->second;
+}
+
+/**
+ * Counting sort of the (row, value) pairs by value. Rows being browsed in order, the transposed
+ * values are sorted.
+ */
+void MVGVisibilityIndex::transpose(const std::vector<int>& offsets, const std::vector<int>& values,
+                                   const int targetCount, std::vector<int>& transposedOffsets,
+                                   std::vector<int>& transposedValues) const
+{
+    assert(!offsets.empty());
+    transposedOffsets.assign(targetCount + 1, 0);
+    for(size_t i = 0; i < values.size(); ++i)
+        ++transposedOffsets[values[i] + 1];
+    for(int i = 0; i < targetCount; ++i)
+        transposedOffsets[i + 1] += transposedOffsets[i];
+
+    transposedValues.resize(values.size());
+    std::vector<int> cursors(transposedOffsets.begin(), transposedOffsets.end() - 1);
+    const int rowCount = static_cast<int>(offsets.size()) - 1;
+    for(int row = 0; row < rowCount; ++row)
+    {
+        for(int i = offsets[row]; i < offsets[row + 1]; ++i)
+            transposedValues[cursors[values[i]]++] = row;
+    }
+}
+
+} // namespace
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include <map>
+
+namespace mayaMVG
+{
+
+/**
+ * Bidirectional visibility between point cloud items and cameras, stored in compressed sparse
+ * row form (one offsets array and one flat values array per direction).
+ * Cameras are referenced by dense integer slots in [0, getCameraCount()), so that per-camera
+ * data can be stored in plain arrays.
+ */
+class MVGVisibilityIndex
+{
+public:
+    MVGVisibilityIndex();
+
+public:
+    void clear();
+    bool isEmpty() const { return _viewIds.empty(); }
+
+    void buildFromPoints(const std::vector<int>& visibilitySizes,
+                         const std::vector<int>& visibilityIds, const int stride = 2);
+    void addCamera(const int viewId, const int* points, const int count);
+    void buildFromCameras();
+
+    int getPointCount() const { return static_cast<int>(_pointOffsets.size()) - 1; }
+    int getCameraCount() const { return static_cast<int>(_viewIds.size()); }
+    int getSlot(const int viewId) const;
+    int getViewId(const int slot) const { return _viewIds[slot]; }
+
+    int getCameraSlots(const int pointId, const int*& slots) const;
+    int getPoints(const int slot, const int*& points) const;
+    void countPointsPerCamera(const std::vector<int>& points,
+                              std::vector<int>& countPerSlot) const;
+
+private:
+    void transpose(const std::vector<int>& offsets, const std::vector<int>& values,
+                   const int targetCount, std::vector<int>& transposedOffsets,
+                   std::vector<int>& transposedValues) const;
+
+private:
+    std::vector<int> _pointOffsets;  // size pointCount + 1
+    std::vector<int> _pointCameras;  // camera slots, sorted per point
+    std::vector<int> _cameraOffsets; // size cameraCount + 1
+    std::vector<int> _cameraPoints;  // point ids, sorted per camera
+    std::vector<int> _viewIds;       // per slot
+    std::map<int, int> _slotPerViewId;
+};
+
+} // namespace
@@ -1,19 +1,19 @@
 #include "MVGMayaUtil.hpp"
 #include "mayaMVG/core/MVGCamera.hpp"
+#include "mayaMVG/core/MVGCameraRegistry.hpp"
 #include "mayaMVG/core/MVGLog.hpp"
 #include "mayaMVG/core/MVGMesh.hpp"
+#include "mayaMVG/core/MVGPointCloud.hpp"
 #include "mayaMVG/qt/MVGPanelWrapper.hpp"
 #include "mayaMVG/qt/MVGMainWidget.hpp"
 #include "mayaMVG/maya/context/MVGMoveManipulator.hpp"
 #include "mayaMVG/maya/context/MVGContext.hpp"
 #include "mayaMVG/maya/context/MVGContextCmd.hpp"
+#include "mayaMVG/maya/context/MVGMeshWatcher.hpp"
 #include <maya/MGlobal.h>
 #include <maya/MFnDependencyNode.h>
 #include <maya/MFnDagNode.h>
-#include <maya/MSelectionList.h>
 #include <maya/MQtUtil.h>
-#include <maya/MItSelectionList.h>
-#include <maya/MFnSingleIndexedComponent.h>
 
 namespace mayaMVG
 {
@@ -39,73 +39,8 @@ static void selectionChangedCB(void*)
     MVGProjectWrapper* project = getProjectWrapper();
     if(!project)
         return;
-    MSelectionList list;
-    MGlobal::getActiveSelectionList(list);
-    MItSelectionList selectionIt(list);
-    MDagPath path;
-    MObject component;
-    QStringList selectedCameras;
-    QStringList selectedMeshes;
-    std::set<int> selectedParticles;
-    bool particleSelectionChanged = false;
-    
-    for (; !selectionIt.isDone(); selectionIt.next())
-    {
-        selectionIt.getDagPath(path, component);
-        path.extendToShape();
-        if(!path.isValid())
-            continue;
-                
-        switch(path.apiType())
-        {
-            case MFn::kCamera:
-                selectedCameras.push_back(path.fullPathName().asChar());
-                break;
-            case MFn::kMesh:
-                selectedMeshes.push_back(path.fullPathName().asChar());
-                break;
-            case MFn::kParticle:
-                if(!component.isNull())
-                {
-                    particleSelectionChanged = true;
-                    const MFnSingleIndexedComponent cpts(component);
-                    MIntArray indices;
-                    cpts.getElements(indices);
-                    for(unsigned int i = 0; i < indices.length(); ++i)
-                        selectedParticles.insert(indices[i]);
-                }
-                break;
-            default:
-                break;
-        }
-    }
-
-    // Synchronisation between IHM/Maya selection
-    if(!project->getActiveSynchro())
-        return;
-    // Compare IHM selection to Maya selection
-    if(!selectedCameras.empty())
-    {
-        QStringList IHMSelectedCamera = project->getSelectedCameras();
-        IHMSelectedCamera.sort();
-        selectedCameras.sort();
-        if(IHMSelectedCamera != selectedCameras)
-            project->addCamerasToIHMSelection(selectedCameras, true);
-    }
-    else
-        project->clearCameraSelection();
-    if(!selectedMeshes.empty())
-    {
-        QStringList IHMSelectedMeshes = project->getSelectedMeshes();
-        IHMSelectedMeshes.sort();
-        selectedMeshes.sort();
-        if(IHMSelectedMeshes != selectedMeshes)
-            project->addMeshesToIHMSelection(selectedMeshes, true);
-    }
-    else
-        project->clearMeshSelection();
-    if(list.length() == 0 || particleSelectionChanged)
-        project->updateParticleSelection(selectedParticles);
+    // Box selections fire many events : only the latest selection is processed, once
+    project->queueMayaSelectionUpdate();
 }
 
 static void currentContextChangedCB(void*)
@@ -120,6 +55,9 @@ static void currentContextChangedCB(void*)
 
 static void sceneChangedCB(void*)
 {
+    MVGCameraRegistry::invalidate();
+    MVGPointCloud::clearPositionsCache();
+    MVGMeshWatcher::clear();
     MVGProjectWrapper* project = getProjectWrapper();
     if(!project)
         return;
@@ -133,46 +71,22 @@ static void sceneChangedCB(void*)
 
 static void newSceneCB(void*)
 {
+    MVGCameraRegistry::invalidate();
+    MVGPointCloud::clearPositionsCache();
+    MVGMeshWatcher::clear();
     MVGMayaUtil::deleteMVGWindow();
 }
 
-static void undoCB(void*)
-{
-    // TODO : rebuild only the modified mesh
-    // TODO : don't rebuild on action that don't modify any mesh
-    MString redoName;
-    MVGMayaUtil::getRedoName(redoName);
-    // Don't rebuild on selection
-    int spaceIndex = redoName.index(' ');
-    MString cmdName = redoName.substring(0, spaceIndex - 1);
-    if(cmdName != "select" && cmdName != "miCreateDefaultPresets")
-    {
-        MString cmd;
-        cmd.format("^1s -e -rebuild ^2s", MVGContextCmd::name, MVGContextCmd::instanceName);
-        MGlobal::executeCommand(cmd);
-    }
-}
-
-static void redoCB(void*)
-{
-    MString undoName;
-    MVGMayaUtil::getUndoName(undoName);
-    // Don't rebuild if selection action
-    int spaceIndex = undoName.index(' ');
-    MString cmdName = undoName.substring(0, spaceIndex - 1);
-    if(cmdName != "select" && cmdName != "miCreateDefaultPresets")
-    {
-        MString cmd;
-        cmd.format("^1s -e -rebuild ^2s", MVGContextCmd::name, MVGContextCmd::instanceName);
-        MGlobal::executeCommand(cmd);
-    }
-}
-
 /**
  * @brief Listen to the Maya nodes creation to update the list of Meshes.
 **/
 static void nodeAddedCB(MObject& node, void*)
 {
+    if(node.hasFn(MFn::kCamera))
+    {
+        MVGCameraRegistry::invalidate();
+        return;
+    }
     MVGProjectWrapper* project = getProjectWrapper();
     if(!project)
         return;
@@ -185,8 +99,11 @@ static void nodeAddedCB(MObject& node, void*)
             if(fn.isIntermediateObject())
                 return;
             MVGMesh mesh(node);
-            if(mesh.isValid())
-                project->addMeshToUI(mesh.getDagPath());
+            if(!mesh.isValid())
+                return;
+            project->addMeshToUI(mesh.getDagPath());
+            // Deletion undone : cache the mesh again if it is active
+            MVGMeshWatcher::setMeshDirty(mesh.getDagPath());
             break;
         }
         case MFn::kSet:
@@ -201,6 +118,11 @@ static void nodeAddedCB(MObject& node, void*)
 
 static void nodeRemovedCB(MObject& node, void*)
 {
+    if(node.hasFn(MFn::kCamera))
+    {
+        MVGCameraRegistry::invalidate();
+        return;
+    }
     MVGProjectWrapper* project = getProjectWrapper();
     if(!project)
         return;
@@ -216,10 +138,7 @@ static void nodeRemovedCB(MObject& node, void*)
             if(!mesh.isValid())
                 return;
             project->removeMeshFromUI(mesh.getDagPath());
-            // TODO : remove only this mesh from cache
-            MString cmd;
-            cmd.format("^1s -e -rebuild ^2s", MVGContextCmd::name, MVGContextCmd::instanceName);
-            MGlobal::executeCommand(cmd);
+            MVGMeshWatcher::setMeshRemoved(mesh.getDagPath());
             break;
         }
         default:
@@ -1,5 +1,7 @@
 #include "mayaMVG/maya/cmd/MVGEditCmd.hpp"
 #include "mayaMVG/maya/mesh/MVGMeshEditNode.hpp"
+#include "mayaMVG/maya/mesh/MVGMeshEditLogNode.hpp"
+#include "mayaMVG/maya/context/MVGMeshWatcher.hpp"
 #include "mayaMVG/core/MVGMesh.hpp"
 #include "mayaMVG/core/MVGProject.hpp"
 #include "mayaMVG/core/MVGLog.hpp"
@@ -8,14 +10,21 @@
 #include <maya/MArgDatabase.h>
 #include <maya/MFnPointArrayData.h>
 #include <maya/MFnIntArrayData.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MGlobal.h>
+#include <algorithm>
 #include <cassert>
 
 namespace mayaMVG
 {
 
 MString MVGEditCmd::_name("MVGEditCmd");
+MString MVGEditCmd::_EDIT_LOG_OPTION("mayaMVGEditLog");
 
 MVGEditCmd::MVGEditCmd()
+    : _clearBD(false)
+    , _editLogCount(0)
+    , _editLogSerial(-1)
 {
 }
 
@@ -38,19 +47,55 @@ MSyntax MVGEditCmd::newSyntax()
 
 MStatus MVGEditCmd::doIt(const MArgList& args)
 {
-    setMeshNode(_meshPath);
-    setModifierNodeType(MVGMeshEditNode::_id);
-    return doModifyPoly();
+    MVGMeshWatcher::Blocker blocker;
+    // Blind data are stored on the mesh node, clearing them doesn't change the geometry
+    if(_editType != MVGMeshEditFactory::kClearBD)
+    {
+        const bool useEditLog = isEditLogEnabled();
+        if(useEditLog)
+            _editLogNode = MVGMeshEditLogNode::getMeshLogNode(_meshPath);
+        if(!_editLogNode.isNull())
+        {
+            _editLogCount = MVGMeshEditLogNode::getEditCount(_editLogNode);
+            CHECK_RETURN_STATUS(MVGMeshEditLogNode::appendEdit(
+                _editLogNode, _editType, _componentIDs, _worldSpacePositions, _editLogSerial))
+        }
+        else
+        {
+            // In edit log mode, the first edit inserts the log node in the mesh history
+            setMeshNode(_meshPath);
+            setModifierNodeType(useEditLog ? MVGMeshEditLogNode::_id : MVGMeshEditNode::_id);
+            CHECK_RETURN_STATUS(doModifyPoly())
+        }
+    }
+    CHECK_RETURN_STATUS(editBlindData())
+    reportChanges(false);
+    return MS::kSuccess;
 }
 
 MStatus MVGEditCmd::redoIt()
 {
-    return redoModifyPoly();
+    MVGMeshWatcher::Blocker blocker;
+    if(!_editLogNode.isNull())
+        CHECK_RETURN_STATUS(MVGMeshEditLogNode::appendEdit(
+            _editLogNode, _editType, _componentIDs, _worldSpacePositions, _editLogSerial))
+    else if(_editType != MVGMeshEditFactory::kClearBD)
+        CHECK_RETURN_STATUS(redoModifyPoly())
+    CHECK_RETURN_STATUS(_blindDataModifier.doIt())
+    reportChanges(false);
+    return MS::kSuccess;
 }
 
 MStatus MVGEditCmd::undoIt()
 {
-    return undoModifyPoly();
+    MVGMeshWatcher::Blocker blocker;
+    CHECK_RETURN_STATUS(_blindDataModifier.undoIt())
+    if(!_editLogNode.isNull())
+        CHECK_RETURN_STATUS(MVGMeshEditLogNode::truncateEdits(_editLogNode, _editLogCount))
+    else if(_editType != MVGMeshEditFactory::kClearBD)
+        CHECK_RETURN_STATUS(undoModifyPoly())
+    reportChanges(true);
+    return MS::kSuccess;
 }
 
 bool MVGEditCmd::isUndoable() const
@@ -68,6 +113,13 @@ MStatus MVGEditCmd::finalize()
 MStatus MVGEditCmd::initModifierNode(MObject node)
 {
     MStatus status;
+    MFnDependencyNode nodeFn(node);
+    if(nodeFn.typeId() == MVGMeshEditLogNode::_id)
+    {
+        int serial = -1;
+        return MVGMeshEditLogNode::appendEdit(node, _editType, _componentIDs,
+                                              _worldSpacePositions, serial);
+    }
     MFnIntArrayData intArrayFn;
     MFnPointArrayData pointArrayFn;
     MObject attributeObject;
@@ -89,12 +141,108 @@ MStatus MVGEditCmd::initModifierNode(MObject node)
     // clear blind data
     MPlug clearBDPlug(node, MVGMeshEditNode::aInClearBlindData);
     clearBDPlug.setValue(_clearBD);
+    // blind data are set by the command
+    MPlug legacyBDPlug(node, MVGMeshEditNode::aInLegacyBlindData);
+    legacyBDPlug.setValue(false);
     // edit type
     MPlug editTypePlug(node, MVGMeshEditNode::aInEditType);
     editTypePlug.setValue(_editType);
     return status;
 }
 
+/**
+ * @return true if edits are accumulated in a single MVGMeshEditLogNode per mesh, instead of
+ * inserting one MVGMeshEditNode per edit in the mesh history
+ */
+bool MVGEditCmd::isEditLogEnabled()
+{
+    bool exists = false;
+    const int value = MGlobal::optionVarIntValue(_EDIT_LOG_OPTION, &exists);
+    return exists && value != 0;
+}
+
+void MVGEditCmd::setEditLogEnabled(const bool enabled)
+{
+    MGlobal::setOptionVarValue(_EDIT_LOG_OPTION, enabled ? 1 : 0);
+}
+
+namespace
+{ // empty namespace
+
+void getVertexObservations(const MVGObservationTable& table, const std::vector<int>& vertexIds,
+                           std::vector<MVGObservationTable::Observation>& observations)
+{
+    observations.clear();
+    for(size_t i = 0; i < vertexIds.size(); ++i)
+    {
+        const MVGObservationTable::Observation* vertexObservations = NULL;
+        const int count = table.getObservations(vertexIds[i], vertexObservations);
+        observations.insert(observations.end(), vertexObservations, vertexObservations + count);
+    }
+}
+
+} // empty namespace
+
+/**
+ * Update the 2D observations of the edited vertices, in a single write of the mesh blind data
+ * attribute. Per-vertex blind data of previous versions are migrated to this attribute here, so
+ * that the migration is undone with the command.
+ * The whole table is read and written back, only the rows of the edited vertices are kept to
+ * report the edit to the manipulators cache.
+ */
+MStatus MVGEditCmd::editBlindData()
+{
+    if(_editType == MVGMeshEditFactory::kAddFace)
+        return MS::kSuccess;
+    MStatus status;
+    MVGMesh mesh(_meshPath);
+    MVGObservationTable observations;
+    status = mesh.getBlindData(observations);
+    CHECK_RETURN_STATUS(status)
+    std::vector<int> vertexIds(_componentIDs.length());
+    for(unsigned int i = 0; i < _componentIDs.length(); ++i)
+        vertexIds[i] = _componentIDs[i];
+    std::sort(vertexIds.begin(), vertexIds.end());
+    vertexIds.erase(std::unique(vertexIds.begin(), vertexIds.end()), vertexIds.end());
+    _previousObservations.vertexIds = vertexIds;
+    getVertexObservations(observations, vertexIds, _previousObservations.observations);
+    if(_editType == MVGMeshEditFactory::kClearBD || _clearBD)
+        observations.unsetObservations(vertexIds);
+    else
+    {
+        assert(_componentIDs.length() == _cameraSpacePositions.length());
+        std::vector<MVGObservationTable::Observation> edits(_componentIDs.length());
+        for(unsigned int i = 0; i < _componentIDs.length(); ++i)
+        {
+            edits[i].vertexId = _componentIDs[i];
+            edits[i].cameraId = _cameraID;
+            edits[i].x = _cameraSpacePositions[i].x;
+            edits[i].y = _cameraSpacePositions[i].y;
+        }
+        observations.setObservations(edits);
+    }
+    _newObservations.vertexIds = vertexIds;
+    getVertexObservations(observations, vertexIds, _newObservations.observations);
+    status = mesh.setBlindData(observations, &_blindDataModifier);
+    CHECK_RETURN_STATUS(status)
+    return _blindDataModifier.doIt();
+}
+
+/**
+ * Report the modified components and their observations to the manipulators cache, mesh
+ * callbacks being blocked while the command runs.
+ *
+ * @param undo : true to report the observations before the edit
+ */
+void MVGEditCmd::reportChanges(const bool undo) const
+{
+    if(_editType == MVGMeshEditFactory::kAddFace)
+        MVGMeshWatcher::setMeshDirty(_meshPath);
+    else
+        MVGMeshWatcher::setObservationsEdited(_meshPath,
+                                              undo ? _previousObservations : _newObservations);
+}
+
 void MVGEditCmd::addFace(const MDagPath& meshPath, const MPointArray& worldSpacePositions,
                          const MPointArray& cameraSpacePositions, int cameraID)
 {
@@ -2,8 +2,10 @@
 
 #include "mayaMVG/maya/cmd/MVGPolyModifierCmd.hpp"
 #include "mayaMVG/maya/mesh/MVGMeshEditFactory.hpp"
+#include "mayaMVG/maya/context/MVGMeshWatcher.hpp"
 #include <maya/MIntArray.h>
 #include <maya/MPointArray.h>
+#include <maya/MDGModifier.h>
 
 class MDagPath;
 
@@ -37,8 +39,17 @@ public:
               const int cameraID, const bool clearBD = false);
     void clearBD(const MDagPath& meshPath, const MIntArray& componentIDs);
 
+public:
+    static bool isEditLogEnabled();
+    static void setEditLogEnabled(const bool enabled);
+
+private:
+    MStatus editBlindData();
+    void reportChanges(const bool undo) const;
+
 public:
     static MString _name;
+    static MString _EDIT_LOG_OPTION;
 
 private:
     MVGMeshEditFactory _editFactory;
@@ -50,6 +61,12 @@ private:
     MPointArray _cameraSpacePositions;
     int _cameraID;
     bool _clearBD;
+    MDGModifier _blindDataModifier; // sets the mesh blind data attribute
+    MVGMeshWatcher::ObservationEdit _previousObservations; // of the edited vertices, for undo
+    MVGMeshWatcher::ObservationEdit _newObservations;
+    MObject _editLogNode;           // log node appended to, null if a modifier node was inserted
+    int _editLogCount;              // number of edits in the log before this command
+    int _editLogSerial;
 };
 
 } // namespace
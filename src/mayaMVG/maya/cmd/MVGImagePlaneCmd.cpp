@@ -9,6 +9,7 @@
 #include <maya/MPlug.h>
 #include <maya/MDagPath.h>
 #include <maya/MPlugArray.h>
+#include <algorithm>
 
 namespace
 { // empty namespace
@@ -17,6 +18,10 @@ static const char* panelFlag = "-p";
 static const char* panelFlagLong = "-panel";
 static const char* loadFlag = "-l";
 static const char* loadFlagLong = "-load";
+static const char* prefetchFlag = "-pf";
+static const char* prefetchFlagLong = "-prefetch";
+static const char* cacheBudgetFlag = "-cb";
+static const char* cacheBudgetFlagLong = "-cacheBudget";
 } // empty namespace
 namespace mayaMVG
 {
@@ -33,6 +38,8 @@ MSyntax MVGImagePlaneCmd::newSyntax()
     MSyntax s;
     s.addFlag(panelFlag, panelFlagLong, MSyntax::kString);
     s.addFlag(loadFlag, loadFlagLong);
+    s.addFlag(prefetchFlag, prefetchFlagLong, MSyntax::kString);
+    s.addFlag(cacheBudgetFlag, cacheBudgetFlagLong, MSyntax::kLong);
     s.enableEdit(false);
     s.enableQuery(false);
     return s;
@@ -44,6 +51,26 @@ MStatus MVGImagePlaneCmd::doIt(const MArgList& args)
     MSyntax syntax = MVGImagePlaneCmd::newSyntax();
     MArgDatabase argData(syntax, args);
 
+    // Memory budget of the image cache, in megabytes
+    if(argData.isFlagSet(cacheBudgetFlag))
+    {
+        int budget = 0;
+        argData.getFlagArgument(cacheBudgetFlag, 0, budget);
+        MVGProject project(MVGProject::_PROJECT);
+        project.setImageCacheBudget(static_cast<size_t>(std::max(budget, 0)) * 1024 * 1024);
+        return status;
+    }
+
+    // Load the image of a camera likely to be displayed next
+    if(argData.isFlagSet(prefetchFlag))
+    {
+        MString camera;
+        argData.getFlagArgument(prefetchFlag, 0, camera);
+        MVGProject project(MVGProject::_PROJECT);
+        project.prefetchImagePlane(camera.asChar());
+        return status;
+    }
+
     if(!argData.isFlagSet(panelFlag))
     {
         LOG_ERROR("Need panel name to load image")
@@ -0,0 +1,116 @@
+#include "MVGMeshHistoryCmd.hpp"
+#include "mayaMVG/core/MVGMesh.hpp"
+#include "mayaMVG/core/MVGLog.hpp"
+#include "mayaMVG/maya/cmd/MVGEditCmd.hpp"
+#include "mayaMVG/maya/MVGMayaUtil.hpp"
+#include <maya/MSyntax.h>
+#include <maya/MArgDatabase.h>
+#include <maya/MDagPath.h>
+
+namespace
+{ // empty namespace
+
+static const char* editLogFlag = "-el";
+static const char* editLogFlagLong = "-editLog";
+static const char* bakeFlag = "-b";
+static const char* bakeFlagLong = "-bake";
+static const char* meshFlag = "-m";
+static const char* meshFlagLong = "-mesh";
+} // empty namespace
+
+namespace mayaMVG
+{
+
+MString MVGMeshHistoryCmd::_name("MVGMeshHistoryCmd");
+
+MVGMeshHistoryCmd::MVGMeshHistoryCmd()
+    : _isUndoable(false)
+{
+}
+
+void* MVGMeshHistoryCmd::creator()
+{
+    return new MVGMeshHistoryCmd();
+}
+
+MSyntax MVGMeshHistoryCmd::newSyntax()
+{
+    MSyntax s;
+    s.addFlag(editLogFlag, editLogFlagLong, MSyntax::kBoolean);
+    s.addFlag(bakeFlag, bakeFlagLong);
+    s.addFlag(meshFlag, meshFlagLong, MSyntax::kString);
+    s.enableEdit(false);
+    s.enableQuery(true);
+    return s;
+}
+
+/**
+ * -editLog : accumulate the edits of each mesh in a single node (see MVGMeshEditLogNode)
+ * -bake : delete the construction history of the given mesh, or of all active meshes
+ */
+MStatus MVGMeshHistoryCmd::doIt(const MArgList& args)
+{
+    MStatus status;
+    MSyntax syntax = MVGMeshHistoryCmd::newSyntax();
+    MArgDatabase argData(syntax, args, &status);
+    CHECK_RETURN_STATUS(status)
+
+    if(argData.isFlagSet(editLogFlag))
+    {
+        if(argData.isQuery())
+        {
+            setResult(MVGEditCmd::isEditLogEnabled());
+            return status;
+        }
+        bool enabled = false;
+        argData.getFlagArgument(editLogFlag, 0, enabled);
+        MVGEditCmd::setEditLogEnabled(enabled);
+    }
+
+    if(argData.isFlagSet(bakeFlag))
+    {
+        std::vector<MVGMesh> meshes;
+        if(argData.isFlagSet(meshFlag))
+        {
+            MString meshName;
+            argData.getFlagArgument(meshFlag, 0, meshName);
+            MDagPath meshPath;
+            status = MVGMayaUtil::getDagPathByName(meshName, meshPath);
+            if(!status)
+            {
+                LOG_ERROR("Invalid mesh: " << meshName)
+                return MS::kFailure;
+            }
+            meshPath.extendToShape();
+            meshes.push_back(MVGMesh(meshPath));
+        }
+        else
+            meshes = MVGMesh::listActiveMeshes();
+        for(std::vector<MVGMesh>::const_iterator it = meshes.begin(); it != meshes.end(); ++it)
+        {
+            MString cmd;
+            cmd.format("delete -constructionHistory \"^1s\"", it->getDagPath().fullPathName());
+            CHECK_RETURN_STATUS(_dgModifier.commandToExecute(cmd))
+        }
+        _isUndoable = true;
+        return redoIt();
+    }
+    return status;
+}
+
+MStatus MVGMeshHistoryCmd::undoIt()
+{
+    return _dgModifier.undoIt();
+}
+
+MStatus MVGMeshHistoryCmd::redoIt()
+{
+    return _dgModifier.doIt();
+}
+
+bool MVGMeshHistoryCmd::isUndoable() const
+{
+    return _isUndoable;
+}
+
+} // namespace
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <maya/MPxCommand.h>
+#include <maya/MDGModifier.h>
+
+namespace mayaMVG
+{
+
+class MVGMeshHistoryCmd : public MPxCommand
+{
+
+public:
+    MVGMeshHistoryCmd();
+
+    static void* creator();
+    static MSyntax newSyntax();
+    virtual MStatus doIt(const MArgList& args);
+    virtual MStatus undoIt();
+    virtual MStatus redoIt();
+    virtual bool isUndoable() const;
+
+public:
+    static MString _name;
+
+private:
+    MDGModifier _dgModifier;
+    bool _isUndoable;
+};
+
+} // namespace
@@ -1,12 +1,34 @@
 #include "MVGSelectClosestCamCmd.hpp"
 #include "mayaMVG/core/MVGProject.hpp"
 #include "mayaMVG/core/MVGCamera.hpp"
+#include "mayaMVG/core/MVGCameraRegistry.hpp"
+#include "mayaMVG/core/MVGGeometryUtil.hpp"
+#include "mayaMVG/core/MVGLog.hpp"
 #include "mayaMVG/maya/MVGMayaUtil.hpp"
 
+#include <maya/MSyntax.h>
+#include <maya/MArgDatabase.h>
+#include <maya/MSelectionList.h>
+#include <maya/MItMeshPolygon.h>
+#include <maya/MStringArray.h>
 #include <maya/MMatrix.h>
 
-#include <cmath>
+#include <algorithm>
 
+namespace
+{ // empty namespace
+
+static const char* countFlag = "-n";
+static const char* countFlagLong = "-count";
+static const char* cameraFlag = "-cam";
+static const char* cameraFlagLong = "-camera";
+static const char* pointFlag = "-p";
+static const char* pointFlagLong = "-point";
+static const char* faceFlag = "-f";
+static const char* faceFlagLong = "-face";
+static const char* directionWeightFlag = "-dw";
+static const char* directionWeightFlagLong = "-directionWeight";
+} // empty namespace
 
 namespace mayaMVG
 {   
@@ -18,33 +40,134 @@ void* MVGSelectClosestCamCmd::creator()
     return new MVGSelectClosestCamCmd();
 }
 
+MSyntax MVGSelectClosestCamCmd::newSyntax()
+{
+    MSyntax s;
+    s.addFlag(countFlag, countFlagLong, MSyntax::kLong);
+    s.addFlag(cameraFlag, cameraFlagLong, MSyntax::kString);
+    s.addFlag(pointFlag, pointFlagLong, MSyntax::kDouble, MSyntax::kDouble, MSyntax::kDouble);
+    s.addFlag(faceFlag, faceFlagLong, MSyntax::kString);
+    s.addFlag(directionWeightFlag, directionWeightFlagLong, MSyntax::kDouble);
+    s.enableEdit(false);
+    s.enableQuery(false);
+    return s;
+}
+
+/**
+ * Without the count flag, select the MVG camera closest to the viewpoint (perspShape by default).
+ * With it, return the names of the N closest MVG cameras to a viewpoint, a point or a face.
+ * Cameras are compared by centre and, except for points, by viewing direction:
+ * |center - point|^2 + directionWeight^2 * |direction - queryDirection|^2.
+ */
 MStatus MVGSelectClosestCamCmd::doIt(const MArgList& args)
 {
-    // Retrieve perspective matrix
-    MDagPath perspDagPath;
-    MVGMayaUtil::getDagPathByName("perspShape", perspDagPath);
-
-    // Browse all MVG cameras
-    std::multimap<float, std::string> camMap;
-    std::vector<MVGCamera> mvgCameras = MVGCamera::getCameras();
-    for(std::vector<MVGCamera>::iterator it = mvgCameras.begin(); it != mvgCameras.end(); ++it)
+    MStatus status;
+    MSyntax syntax = MVGSelectClosestCamCmd::newSyntax();
+    MArgDatabase argData(syntax, args, &status);
+    CHECK_RETURN_STATUS(status)
+
+    int count = 1;
+    if(argData.isFlagSet(countFlag))
+        argData.getFlagArgument(countFlag, 0, count);
+    if(count < 1)
+    {
+        LOG_ERROR("Camera count must be positive")
+        return MS::kFailure;
+    }
+    // Weight of the viewing direction against the centre distance. Roll around the viewing axis
+    // and scale are ignored, unlike the former Frobenius norm of the matrix difference.
+    double directionWeight = 1.0;
+    if(argData.isFlagSet(directionWeightFlag))
+        argData.getFlagArgument(directionWeightFlag, 0, directionWeight);
+
+    // Query
+    aliceVision::Vec3 point;
+    aliceVision::Vec3 direction;
+    bool useDirection = true;
+    int excludedId = -1;
+    if(argData.isFlagSet(pointFlag))
+    {
+        for(unsigned int i = 0; i < 3; ++i)
+            argData.getFlagArgument(pointFlag, i, point(i));
+        useDirection = false;
+    }
+    else if(argData.isFlagSet(faceFlag))
     {
-        // Compute Frobenius norm
-        MDagPath camDagPath = it->getDagPath();
-        MMatrix matrix = perspDagPath.inclusiveMatrix() - camDagPath.inclusiveMatrix();
-        float norm = 0;
-        for(size_t i = 0; i < 4; ++i)
-            for(size_t j = 0; j < 4; ++j)
-                norm += std::pow(matrix[i][j], 2.0);
-        camMap.insert(std::make_pair(norm, camDagPath.partialPathName().asChar()));
+        MString face;
+        argData.getFlagArgument(faceFlag, 0, face);
+        MSelectionList list;
+        MDagPath meshPath;
+        MObject component;
+        status = list.add(face);
+        if(status)
+            status = list.getDagPath(0, meshPath, component);
+        MItMeshPolygon faceIt(meshPath, component, &status);
+        if(!status || component.isNull() || faceIt.isDone())
+        {
+            LOG_ERROR("Invalid face: " << face)
+            return MS::kFailure;
+        }
+        MVector normal;
+        faceIt.getNormal(normal, MSpace::kWorld);
+        point = TO_VEC3(faceIt.center(MSpace::kWorld));
+        // Cameras facing the face
+        direction = -TO_VEC3(normal.normal());
     }
-    if(!camMap.empty())
+    else
+    {
+        MString camera("perspShape");
+        if(argData.isFlagSet(cameraFlag))
+            argData.getFlagArgument(cameraFlag, 0, camera);
+        MDagPath cameraPath;
+        status = MVGMayaUtil::getDagPathByName(camera, cameraPath);
+        if(!status)
+        {
+            LOG_ERROR("Invalid camera: " << camera)
+            return MS::kFailure;
+        }
+        cameraPath.extendToShape();
+        // The viewpoint itself is not a candidate
+        MVGCamera mvgCamera(cameraPath);
+        if(mvgCamera.isValid())
+            excludedId = mvgCamera.getId();
+        const MMatrix matrix = cameraPath.inclusiveMatrix();
+        point = aliceVision::Vec3(matrix[3][0], matrix[3][1], matrix[3][2]);
+        // Maya cameras look down their local -Z axis
+        direction = -aliceVision::Vec3(matrix[2][0], matrix[2][1], matrix[2][2]).normalized();
+    }
+
+    // Search
+    const MVGCameraIndex& index = MVGCameraRegistry::getCameraIndex();
+    const int searchCount = (excludedId < 0) ? count : count + 1;
+    std::vector<int> viewIds;
+    if(useDirection)
+        index.findNearest(point, direction, directionWeight, searchCount, viewIds);
+    else
+        index.findNearest(point, searchCount, viewIds);
+
+    std::vector<std::string> cameraNames;
+    for(size_t i = 0; i < viewIds.size() && cameraNames.size() < static_cast<size_t>(count); ++i)
+    {
+        MDagPath cameraPath;
+        if(viewIds[i] == excludedId || !MVGCameraRegistry::getDagPath(viewIds[i], cameraPath))
+            continue;
+        cameraNames.push_back(cameraPath.partialPathName().asChar());
+    }
+
+    if(argData.isFlagSet(countFlag))
+    {
+        MStringArray result;
+        for(size_t i = 0; i < cameraNames.size(); ++i)
+            result.append(cameraNames[i].c_str());
+        setResult(result);
+        return status;
+    }
+    if(!cameraNames.empty())
     {
         MVGProject project(MVGProject::_PROJECT);
-        std::vector<std::string> cams(1, camMap.begin()->second);
-        project.selectCameras(cams);
+        project.selectCameras(cameraNames);
     }
     return MS::kSuccess;
 }
 
-}
\ No newline at end of file
+}
@@ -12,6 +12,7 @@ public:
     MVGSelectClosestCamCmd(){};
 
     static void* creator();
+    static MSyntax newSyntax();
     virtual MStatus doIt(const MArgList& args);
 
 public:
@@ -19,4 +20,4 @@ public:
 
 };
 
-}
\ No newline at end of file
+}
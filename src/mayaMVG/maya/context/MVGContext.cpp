@@ -121,7 +121,7 @@ bool MVGContext::eventFilter(QObject* obj, QEvent* e)
                         if(cmd->doIt(args))
                         {
                             cmd->finalize();
-                            _manipulatorCache.rebuildMeshesCache();
+                            _manipulatorCache.updateChangedMeshesCache();
                             _manipulatorCache.clearSelectedComponent();
                         }
                         break;
@@ -17,6 +17,8 @@ namespace
 
 static const char* rebuildFlag = "-r";
 static const char* rebuildFlagLong = "-rebuild";
+static const char* updateFlag = "-u";
+static const char* updateFlagLong = "-update";
 static const char* meshFlag = "-m";
 static const char* meshFlagLong = "-mesh";
 static const char* editModeFlag = "-em";
@@ -65,6 +67,12 @@ MStatus MVGContextCmd::doEditFlags()
         }
         cache.rebuildMeshesCache();
     }
+    // -update: apply the mesh changes recorded since the last update (see MVGMeshWatcher)
+    if(argData.isFlagSet(updateFlag))
+    {
+        _context->getCache().updateChangedMeshesCache();
+        return MS::kSuccess;
+    }
     if(argData.isFlagSet(editModeFlag))
     {
         MString editModeString;
@@ -168,6 +176,8 @@ MStatus MVGContextCmd::appendSyntax()
     MSyntax mySyntax = syntax();
     if(MS::kSuccess != mySyntax.addFlag(rebuildFlag, rebuildFlagLong))
         return MS::kFailure;
+    if(MS::kSuccess != mySyntax.addFlag(updateFlag, updateFlagLong))
+        return MS::kFailure;
     if(MS::kSuccess != mySyntax.addFlag(meshFlag, meshFlagLong, MSyntax::kString))
         return MS::kFailure;
     if(MS::kSuccess != mySyntax.addFlag(editModeFlag, editModeFlagLong, MSyntax::kString))
@@ -155,8 +155,10 @@ MStatus MVGCreateManipulator::doPress(M3dView& view)
     if(_cache->getActiveCamera().getId() != _cameraID)
     {
         _cameraID = _cache->getActiveCamera().getId();
-        _cache->getActiveCamera().getVisibleItems(_visiblePointCloudItems);
+        _cache->getActiveCamera().getVisibleIndexes(_visiblePointCloudIndexes);
     }
+    // built again on the first projection of this press (view or point cloud may have changed)
+    _visiblePointsGrid.clear();
     // set this view as the active view
     _cache->setActiveView(view);
 
@@ -285,7 +287,8 @@ void MVGCreateManipulator::computeFinalWSPoints(M3dView& view)
         previewCSPoints.append(getMousePosition(view));
         // project clicked points on point cloud
         MVGPointCloud cloud(MVGProject::_CLOUD);
-        cloud.projectPoints(view, _visiblePointCloudItems, previewCSPoints, _finalWSPoints);
+        cloud.projectPoints(view, _visiblePointCloudIndexes, _visiblePointsGrid, previewCSPoints,
+                            _finalWSPoints);
         return;
     }
     if(_cameraIDToClickedCSPoints.second.length() > 0)
@@ -301,7 +304,7 @@ void MVGCreateManipulator::computeFinalWSPoints(M3dView& view)
 
     // Retrieve edge points preserving on press edge length
     MPointArray intermediateCSEdgePoints;
-    getIntermediateCSEdgePoints(view, _onPressIntersectedComponent.edge, _onPressCSPoint,
+    getIntermediateCSEdgePoints(view, _onPressIntersectedComponent, _onPressCSPoint,
                                 intermediateCSEdgePoints);
     assert(intermediateCSEdgePoints.length() == 2);
     if(_doSnap &&
@@ -330,9 +333,9 @@ bool MVGCreateManipulator::computePCPoints(M3dView& view, MPointArray& finalWSPo
     // Get camera space points to project
     MPointArray cameraSpacePoints;
     cameraSpacePoints.append(MVGGeometryUtil::worldToCameraSpace(
-        view, _onPressIntersectedComponent.edge->vertex1->worldPosition));
+        view, _onPressIntersectedComponent.getEdgeVertex1()->worldPosition));
     cameraSpacePoints.append(MVGGeometryUtil::worldToCameraSpace(
-        view, _onPressIntersectedComponent.edge->vertex2->worldPosition));
+        view, _onPressIntersectedComponent.getEdgeVertex2()->worldPosition));
     cameraSpacePoints.append(intermediateCSEdgePoints[1]);
     cameraSpacePoints.append(intermediateCSEdgePoints[0]);
 
@@ -340,18 +343,18 @@ bool MVGCreateManipulator::computePCPoints(M3dView& view, MPointArray& finalWSPo
     MPoint projectedMouseWS;
     MVGPointCloud cloud(MVGProject::_CLOUD);
     MPointArray constraintedPoints;
-    constraintedPoints.append(_onPressIntersectedComponent.edge->vertex1->worldPosition);
-    constraintedPoints.append(_onPressIntersectedComponent.edge->vertex2->worldPosition);
-    if(!cloud.projectPointsWithLineConstraint(view, _visiblePointCloudItems, cameraSpacePoints,
-                                              constraintedPoints, getMousePosition(view),
-                                              projectedMouseWS))
+    constraintedPoints.append(_onPressIntersectedComponent.getEdgeVertex1()->worldPosition);
+    constraintedPoints.append(_onPressIntersectedComponent.getEdgeVertex2()->worldPosition);
+    if(!cloud.projectPointsWithLineConstraint(view, _visiblePointCloudIndexes, _visiblePointsGrid,
+                                              cameraSpacePoints, constraintedPoints,
+                                              getMousePosition(view), projectedMouseWS))
         return false;
     MPointArray translatedWSEdgePoints;
-    getTranslatedWSEdgePoints(view, _onPressIntersectedComponent.edge, _onPressCSPoint,
+    getTranslatedWSEdgePoints(view, _onPressIntersectedComponent, _onPressCSPoint,
                               projectedMouseWS, translatedWSEdgePoints);
     // Begin with second edge's vertex to keep normal
-    finalWSPoints.append(_onPressIntersectedComponent.edge->vertex2->worldPosition);
-    finalWSPoints.append(_onPressIntersectedComponent.edge->vertex1->worldPosition);
+    finalWSPoints.append(_onPressIntersectedComponent.getEdgeVertex2()->worldPosition);
+    finalWSPoints.append(_onPressIntersectedComponent.getEdgeVertex1()->worldPosition);
     finalWSPoints.append(translatedWSEdgePoints[0]);
     finalWSPoints.append(translatedWSEdgePoints[1]);
 
@@ -388,8 +391,8 @@ bool MVGCreateManipulator::computeAdjacentPoints(M3dView& view, MPointArray& fin
         return false;
     assert(projectedWSPoints.length() == 2);
     // Begin with second edge's vertex to keep normal
-    finalWSPoints.append(_onPressIntersectedComponent.edge->vertex2->worldPosition);
-    finalWSPoints.append(_onPressIntersectedComponent.edge->vertex1->worldPosition);
+    finalWSPoints.append(_onPressIntersectedComponent.getEdgeVertex2()->worldPosition);
+    finalWSPoints.append(_onPressIntersectedComponent.getEdgeVertex1()->worldPosition);
     finalWSPoints.append(projectedWSPoints[0]);
     finalWSPoints.append(projectedWSPoints[1]);
 
@@ -405,10 +408,10 @@ bool MVGCreateManipulator::snapToIntersectedEdge(
     if(_onPressIntersectedComponent.type != MFn::kMeshEdgeComponent)
         return false;
     finalWSPoints.clear();
-    const MPoint& pressedVertex1 = _onPressIntersectedComponent.edge->vertex1->worldPosition;
-    const MPoint& pressedVertex2 = _onPressIntersectedComponent.edge->vertex2->worldPosition;
-    const MPoint& intersectedVertex1 = intersectedEdge.edge->vertex1->worldPosition;
-    const MPoint& intersectedVertex2 = intersectedEdge.edge->vertex2->worldPosition;
+    const MPoint& pressedVertex1 = _onPressIntersectedComponent.getEdgeVertex1()->worldPosition;
+    const MPoint& pressedVertex2 = _onPressIntersectedComponent.getEdgeVertex2()->worldPosition;
+    const MPoint& intersectedVertex1 = intersectedEdge.getEdgeVertex1()->worldPosition;
+    const MPoint& intersectedVertex2 = intersectedEdge.getEdgeVertex2()->worldPosition;
 
     // Don't snap on adjacent edge
     if(pressedVertex1 == intersectedVertex1 || pressedVertex1 == intersectedVertex2 ||
@@ -448,8 +451,8 @@ bool MVGCreateManipulator::snapToIntersectedVertex(M3dView& view, MPointArray& f
         return false;
     finalWSPoints.setLength(4);
     // Begin with second edge's vertex to keep normal
-    finalWSPoints[0] = _onPressIntersectedComponent.edge->vertex2->worldPosition;
-    finalWSPoints[1] = _onPressIntersectedComponent.edge->vertex1->worldPosition;
+    finalWSPoints[0] = _onPressIntersectedComponent.getEdgeVertex2()->worldPosition;
+    finalWSPoints[1] = _onPressIntersectedComponent.getEdgeVertex1()->worldPosition;
 
     // Get intersection with "intermediateCSEdgePoints"
     MVGManipulatorCache::MVGComponent edgeIntersectedComponent;
@@ -473,8 +476,8 @@ bool MVGCreateManipulator::snapToIntersectedVertex(M3dView& view, MPointArray& f
     // extended egde to compute the last point.
     if(_snapedPoints.length() == 1)
     {
-        MVector onPressEdgeVector = _onPressIntersectedComponent.edge->vertex2->worldPosition -
-                                    _onPressIntersectedComponent.edge->vertex1->worldPosition;
+        MVector onPressEdgeVector = _onPressIntersectedComponent.getEdgeVertex2()->worldPosition -
+                                    _onPressIntersectedComponent.getEdgeVertex1()->worldPosition;
         if(_snapedPoints[0] == 2)
             _finalWSPoints[3] = _finalWSPoints[2] + onPressEdgeVector;
         if(_snapedPoints[0] == 3)
@@ -49,8 +49,8 @@ void MVGManipulator::getIntersectedPoints(M3dView& view, MPointArray& positions,
     {
         case MFn::kBlindData:
         {
-            MPoint pointCSPosition =
-                intersectedComponent.vertex->blindData[_cache->getActiveCamera().getId()];
+            MPoint pointCSPosition;
+            intersectedComponent.getBlindData(_cache->getActiveCamera().getId(), pointCSPosition);
             intersectedPositions.append(MVGGeometryUtil::cameraToWorldSpace(view, pointCSPosition));
             break;
         }
@@ -58,8 +58,8 @@ void MVGManipulator::getIntersectedPoints(M3dView& view, MPointArray& positions,
             intersectedPositions.append(intersectedComponent.vertex->worldPosition);
             break;
         case MFn::kMeshEdgeComponent:
-            intersectedPositions.append(intersectedComponent.edge->vertex1->worldPosition);
-            intersectedPositions.append(intersectedComponent.edge->vertex2->worldPosition);
+            intersectedPositions.append(intersectedComponent.getEdgeVertex1()->worldPosition);
+            intersectedPositions.append(intersectedComponent.getEdgeVertex2()->worldPosition);
             break;
         default:
             break;
@@ -106,55 +106,55 @@ const MPointArray MVGManipulator::getIntersectedPoints(M3dView& view,
  * This computation is in 2D Camera Space.
  *
  * @param[in] view Viewort
- * @param[in] onPressEdgeData clicked edge information
+ * @param[in] onPressEdge clicked edge
  * @param[in] onPressCSMousePos clicked mouse position in Camera Space coordinates
  * @param[out] intermediateCSEdgePoints the 2 new points (D and C) of the parallelogram
  */
 void MVGManipulator::getIntermediateCSEdgePoints(
-    M3dView& view, const MVGManipulatorCache::EdgeData* onPressEdgeData,
+    M3dView& view, const MVGManipulatorCache::MVGComponent& onPressEdge,
     const MPoint& onPressCSMousePos, MPointArray& intermediateCSEdgePoints)
 {
-    assert(onPressEdgeData != NULL);
+    assert(onPressEdge.edge != NULL);
     // vertex 1
     MVector mouseToVertexCSOffset =
-        MVGGeometryUtil::worldToCameraSpace(view, onPressEdgeData->vertex1->worldPosition) -
+        MVGGeometryUtil::worldToCameraSpace(view, onPressEdge.getEdgeVertex1()->worldPosition) -
         onPressCSMousePos;
     intermediateCSEdgePoints.append(getMousePosition(view) + mouseToVertexCSOffset);
     // vertex 2
     mouseToVertexCSOffset =
-        MVGGeometryUtil::worldToCameraSpace(view, onPressEdgeData->vertex2->worldPosition) -
+        MVGGeometryUtil::worldToCameraSpace(view, onPressEdge.getEdgeVertex2()->worldPosition) -
         onPressCSMousePos;
     intermediateCSEdgePoints.append(getMousePosition(view) + mouseToVertexCSOffset);
 }
 
 const MPointArray
 MVGManipulator::getIntermediateCSEdgePoints(M3dView& view,
-                                            const MVGManipulatorCache::EdgeData* onPressEdgeData,
+                                            const MVGManipulatorCache::MVGComponent& onPressEdge,
                                             const MPoint& onPressCSPoint)
 {
-    assert(onPressEdgeData != NULL);
+    assert(onPressEdge.edge != NULL);
     MPointArray intermediateCSEdgePoints;
-    getIntermediateCSEdgePoints(view, onPressEdgeData, onPressCSPoint, intermediateCSEdgePoints);
+    getIntermediateCSEdgePoints(view, onPressEdge, onPressCSPoint, intermediateCSEdgePoints);
     return intermediateCSEdgePoints;
 }
 
 void MVGManipulator::getTranslatedWSEdgePoints(M3dView& view,
-                                               const MVGManipulatorCache::EdgeData* originEdgeData,
+                                               const MVGManipulatorCache::MVGComponent& originEdge,
                                                MPoint& originCSPosition, MPoint& targetWSPosition,
                                                MPointArray& targetEdgeWSPositions) const
 {
-    assert(originEdgeData != NULL);
+    assert(originEdge.edge != NULL);
     MVector edgeCSVector =
-        MVGGeometryUtil::worldToCameraSpace(view, originEdgeData->vertex1->worldPosition) -
-        MVGGeometryUtil::worldToCameraSpace(view, originEdgeData->vertex2->worldPosition);
+        MVGGeometryUtil::worldToCameraSpace(view, originEdge.getEdgeVertex1()->worldPosition) -
+        MVGGeometryUtil::worldToCameraSpace(view, originEdge.getEdgeVertex2()->worldPosition);
     MVector vertex1ToMouseCSVector =
         originCSPosition -
-        MVGGeometryUtil::worldToCameraSpace(view, originEdgeData->vertex1->worldPosition);
+        MVGGeometryUtil::worldToCameraSpace(view, originEdge.getEdgeVertex1()->worldPosition);
     float ratioVertex1 = vertex1ToMouseCSVector.length() / edgeCSVector.length();
     float ratioVertex2 = 1.f - ratioVertex1;
 
     MVector edgeWSVector =
-        originEdgeData->vertex1->worldPosition - originEdgeData->vertex2->worldPosition;
+        originEdge.getEdgeVertex1()->worldPosition - originEdge.getEdgeVertex2()->worldPosition;
     targetEdgeWSPositions.append(targetWSPosition + ratioVertex1 * edgeWSVector);
     targetEdgeWSPositions.append(targetWSPosition - ratioVertex2 * edgeWSVector);
 }
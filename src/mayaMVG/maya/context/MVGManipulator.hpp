@@ -1,7 +1,7 @@
 #pragma once
 
 #include "mayaMVG/core/MVGGeometryUtil.hpp"
-#include "mayaMVG/core/MVGPointCloudItem.hpp"
+#include "mayaMVG/geometry/MVGViewPointGrid.hpp"
 #include "mayaMVG/maya/context/MVGManipulatorCache.hpp"
 #include "mayaMVG/maya/context/MVGContext.hpp"
 #include "mayaMVG/maya/cmd/MVGEditCmd.hpp"
@@ -38,14 +38,14 @@ public:
     const MPointArray getIntersectedPoints(M3dView&, Space = kCamera) const;
     void getIntersectedPoints(M3dView&, MPointArray&, Space = kCamera) const;
     void getIntermediateCSEdgePoints(M3dView& view,
-                                     const MVGManipulatorCache::EdgeData* onPressEdgeData,
+                                     const MVGManipulatorCache::MVGComponent& onPressEdge,
                                      const MPoint& onPressCSMousePos,
                                      MPointArray& intermediateCSEdgePoints);
     const MPointArray
-    getIntermediateCSEdgePoints(M3dView& view, const MVGManipulatorCache::EdgeData* onPressEdgeData,
+    getIntermediateCSEdgePoints(M3dView& view, const MVGManipulatorCache::MVGComponent& onPressEdge,
                                 const MPoint& onPressCSPoint);
     void getTranslatedWSEdgePoints(M3dView& view,
-                                   const MVGManipulatorCache::EdgeData* originEdgeData,
+                                   const MVGManipulatorCache::MVGComponent& originEdge,
                                    MPoint& originCSPosition, MPoint& targetWSPosition,
                                    MPointArray& targetEdgeWSPositions) const;
 
@@ -64,7 +64,8 @@ protected:
     MPoint _onPressCSPoint;
     MPointArray _finalWSPoints;
     int _cameraID;
-    std::vector<MVGPointCloudItem> _visiblePointCloudItems;
+    MIntArray _visiblePointCloudIndexes;
+    MVGViewPointGrid _visiblePointsGrid;
     MIntArray _snapedPoints;
     bool _doDrag;
 
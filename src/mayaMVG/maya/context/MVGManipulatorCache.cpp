@@ -2,12 +2,16 @@
 #include "mayaMVG/core/MVGMesh.hpp"
 #include "mayaMVG/core/MVGLog.hpp"
 #include "mayaMVG/maya/context/MVGManipulatorCache.hpp"
+#include "mayaMVG/maya/context/MVGMeshWatcher.hpp"
 #include "mayaMVG/maya/MVGMayaUtil.hpp"
 
 #include <maya/MItMeshVertex.h>
 #include <maya/MItMeshEdge.h>
+#include <maya/MFnMesh.h>
 
 #include <list>
+#include <cmath>
+#include <algorithm>
 
 namespace mayaMVG
 {
@@ -15,25 +19,75 @@ namespace mayaMVG
 namespace
 { // empty namespace
 
-float minimumDistanceToEdge(MPoint A, MPoint B, MPoint P)
+double minimumDistanceToEdge(const double ax, const double ay, const double bx, const double by,
+                             const double px, const double py)
 {
-    if(A == B)
-        return P.distanceTo(A);
+    const double abx = bx - ax;
+    const double aby = by - ay;
+    const double squaredLength = abx * abx + aby * aby;
+    if(squaredLength == 0.0)
+        return std::sqrt((px - ax) * (px - ax) + (py - ay) * (py - ay));
     // consider the line extending the segment, parameterized as A + t (B - A).
     // we find projection of point p onto the line.
     // it falls where t = [(P-A) . (B-A)] / |B-A|^2
-    MVector vector(B - A);
-    const float t = (MVector(P - A) * vector) / pow(vector.length(), 2);
-    if(t < 0.0)
-        return P.distanceTo(A); // beyond the 'A' end of the segment
-    else if(t > 1.0)
-        return P.distanceTo(B);               // beyond the 'B' end of the segment
-    const MPoint projection = A + t * vector; // projection falls on the segment
-    return P.distanceTo(projection);
+    const double t = ((px - ax) * abx + (py - ay) * aby) / squaredLength;
+    if(t < 0.0) // beyond the 'A' end of the segment
+        return std::sqrt((px - ax) * (px - ax) + (py - ay) * (py - ay));
+    else if(t > 1.0) // beyond the 'B' end of the segment
+        return std::sqrt((px - bx) * (px - bx) + (py - by) * (py - by));
+    // projection falls on the segment
+    const double dx = px - (ax + t * abx);
+    const double dy = py - (ay + t * aby);
+    return std::sqrt(dx * dx + dy * dy);
 }
 
 } // empty namespace
 
+MVGManipulatorCache::CameraData* MVGManipulatorCache::MeshData::getCameraData(const int cameraID)
+{
+    std::map<int, int>::const_iterator slotIt = cameraSlots.find(cameraID);
+    if(slotIt == cameraSlots.end())
+        return NULL;
+    return &cameras[slotIt->second];
+}
+
+/**
+ * @param[in] vertexIndex
+ * @param[in] cameraID
+ * @param[out] csPosition : clicked camera space position of the vertex in this camera
+ * @return false if the vertex has not been placed in this camera
+ */
+bool MVGManipulatorCache::MeshData::getBlindData(const int vertexIndex, const int cameraID,
+                                                 MPoint& csPosition) const
+{
+    csPosition = MPoint();
+    return observations.getObservation(vertexIndex, cameraID, csPosition.x, csPosition.y);
+}
+
+/**
+ * @param[in] vertexIndex
+ * @param[out] csPositions : map from cameraIDs to clicked camera space positions of the vertex
+ */
+void MVGManipulatorCache::MeshData::getBlindData(const int vertexIndex,
+                                                 std::map<int, MPoint>& csPositions) const
+{
+    csPositions.clear();
+    const MVGObservationTable::Observation* vertexObservations = NULL;
+    const int count = observations.getObservations(vertexIndex, vertexObservations);
+    for(int i = 0; i < count; ++i)
+        csPositions[vertexObservations[i].cameraId] =
+            MPoint(vertexObservations[i].x, vertexObservations[i].y);
+}
+
+/**
+ * @return the number of cameras in which the vertex has been placed
+ */
+int MVGManipulatorCache::MeshData::getBlindDataCount(const int vertexIndex) const
+{
+    const MVGObservationTable::Observation* vertexObservations = NULL;
+    return observations.getObservations(vertexIndex, vertexObservations);
+}
+
 MVGManipulatorCache::MVGManipulatorCache()
 {
 }
@@ -94,6 +148,10 @@ const MVGManipulatorCache::MeshData& MVGManipulatorCache::getMeshData(const std:
 }
 void MVGManipulatorCache::rebuildMeshesCache()
 {
+    // Pending changes are covered by the full rebuild
+    MVGMeshWatcher::Changes changes;
+    MVGMeshWatcher::takeChanges(changes);
+
     // List all meshes currently stored in meshData
     std::list<std::string> meshesList;
     for(std::map<std::string, MeshData>::iterator it = _meshData.begin(); it != _meshData.end();
@@ -113,7 +171,7 @@ void MVGManipulatorCache::rebuildMeshesCache()
     // Remove data for meshes that does not exist anymore
     for(std::list<std::string>::iterator meshIt = meshesList.begin(); meshIt != meshesList.end();
         ++meshIt)
-        _meshData.erase(*meshIt);
+        removeMeshCache(*meshIt);
 }
 
 void MVGManipulatorCache::rebuildMeshCache(const MDagPath& path)
@@ -124,12 +182,10 @@ void MVGManipulatorCache::rebuildMeshCache(const MDagPath& path)
     // Remove non active mesh
     if(!mesh.isActive())
     {
-        std::map<std::string, MeshData>::iterator foundIt =
-            _meshData.find(path.fullPathName().asChar());
-        if(foundIt != _meshData.end())
-            _meshData.erase(foundIt);
+        removeMeshCache(path.fullPathName().asChar());
         return;
     }
+    MVGMeshWatcher::watch(path);
     // Retrieve selectedComponent info
     MDagPath meshPath = _selectedComponent.meshPath;
     MFn::Type type = MFn::kInvalid;
@@ -172,29 +228,42 @@ void MVGManipulatorCache::rebuildMeshCache(const MDagPath& path)
         CHECK(status)
         int numConnectedEdges = -1;
         CHECK(vIt.numConnectedEdges(numConnectedEdges))
-        // blind data
         VertexData& vertex = newMeshData.vertices[index];
         vertex.index = index;
         vertex.numConnectedEdges = numConnectedEdges;
         vertex.worldPosition = vIt.position(MSpace::kWorld, &status);
-        mesh.getBlindData(index, vertex.blindData);
         vIt.next();
     }
+    // blind data, read at once
+    mesh.getBlindData(newMeshData.observations);
     // fill it w/ edges data
+    newMeshData.edgeVertices.resize(2 * newMeshData.edges.size());
     while(!eIt.isDone())
     {
-        assert(eIt.index(0) < newMeshData.vertices.size());
-        assert(eIt.index(1) < newMeshData.vertices.size());
-        std::vector<VertexData>::iterator v1It = newMeshData.vertices.begin();
-        std::vector<VertexData>::iterator v2It = newMeshData.vertices.begin();
-        v1It += eIt.index(0);
-        v2It += eIt.index(1);
-        EdgeData& edge = newMeshData.edges[eIt.index()];
-        edge.index = eIt.index();
-        edge.vertex1 = &(*v1It);
-        edge.vertex2 = &(*v2It);
+        const int edgeIndex = eIt.index();
+        const int vertex1Index = eIt.index(0);
+        const int vertex2Index = eIt.index(1);
+        assert(vertex1Index < static_cast<int>(newMeshData.vertices.size()));
+        assert(vertex2Index < static_cast<int>(newMeshData.vertices.size()));
+        newMeshData.edges[edgeIndex].index = edgeIndex;
+        newMeshData.edgeVertices[2 * edgeIndex] = vertex1Index;
+        newMeshData.edgeVertices[2 * edgeIndex + 1] = vertex2Index;
         eIt.next();
     }
+    // fill vertex to edges adjacency
+    const std::vector<int>& edgeVertices = newMeshData.edgeVertices;
+    std::vector<int>& offsets = newMeshData.vertexEdgeOffsets;
+    offsets.assign(newMeshData.vertices.size() + 1, 0);
+    for(size_t i = 0; i < edgeVertices.size(); ++i)
+        ++offsets[edgeVertices[i] + 1];
+    for(size_t i = 1; i < offsets.size(); ++i)
+        offsets[i] += offsets[i - 1];
+    std::vector<int> edgeSlots(offsets.begin(), offsets.end() - 1);
+    newMeshData.vertexEdges.resize(edgeVertices.size());
+    for(size_t i = 0; i < edgeVertices.size(); ++i)
+        newMeshData.vertexEdges[edgeSlots[edgeVertices[i]]++] = i / 2;
+    // the whole mesh is up to date
+    _dirtyVertices.erase(pathsString);
 
     if(meshPath == path)
         updateSelectedComponent(meshPath, type, index);
@@ -205,10 +274,8 @@ void MVGManipulatorCache::checkForCameraSpacePositions(M3dView& view, MeshData&
 {
     if(meshData.vertices.empty())
         return;
-    std::map<int, MPoint>& cameraSpacePoints = meshData.vertices.begin()->cameraSpacePoints;
-    std::map<int, MPoint>::iterator cameraIt = cameraSpacePoints.find(cameraID);
     // We compute position only if there are not in the cache to avoid computing them all the time
-    if(cameraIt == cameraSpacePoints.end())
+    if(!meshData.getCameraData(cameraID))
         computeMeshCacheForCameraID(view, meshData, cameraID);
 }
 
@@ -222,14 +289,65 @@ void MVGManipulatorCache::checkForCameraSpacePositions(M3dView& view, MeshData&
 void MVGManipulatorCache::computeMeshCacheForCameraID(M3dView& view, MeshData& meshData,
                                                       const int cameraID)
 {
-    std::vector<VertexData>& vertices = meshData.vertices;
-    for(std::vector<VertexData>::iterator vertexIt = vertices.begin(); vertexIt != vertices.end();
-        ++vertexIt)
+    const std::vector<VertexData>& vertices = meshData.vertices;
+    if(vertices.empty())
+        return;
+
+    // Retrieve or add the camera slot
+    CameraData* cameraData = meshData.getCameraData(cameraID);
+    if(!cameraData)
+    {
+        meshData.cameraSlots[cameraID] = meshData.cameras.size();
+        meshData.cameras.push_back(CameraData());
+        cameraData = &meshData.cameras.back();
+        cameraData->cameraID = cameraID;
+    }
+
+    // Camera space positions (view parameters are retrieved once for all vertices)
+    const size_t vertexCount = vertices.size();
+    MVGGeometryUtil::getViewProjection(view, cameraData->projection);
+    aliceVision::Mat3X worldPositions(3, vertexCount);
+    for(size_t i = 0; i < vertexCount; ++i)
+        worldPositions.col(i) = TO_VEC3(vertices[i].worldPosition);
+    std::vector<double>& xs = cameraData->xs;
+    std::vector<double>& ys = cameraData->ys;
+    MVGGeometry::worldToCameraSpace(cameraData->projection, worldPositions, xs, ys);
+    double minX = *std::min_element(xs.begin(), xs.end());
+    double maxX = *std::max_element(xs.begin(), xs.end());
+    double minY = *std::min_element(ys.begin(), ys.end());
+    double maxY = *std::max_element(ys.begin(), ys.end());
+
+    // Vertices grid
+    cameraData->vertexGrid.reset(minX, minY, maxX, maxY, vertexCount);
+    for(size_t i = 0; i < vertexCount; ++i)
+        cameraData->vertexGrid.insert(i, xs[i], ys[i]);
+
+    // Edges grid (segment bounding boxes)
+    const std::vector<int>& edgeVertices = meshData.edgeVertices;
+    const size_t edgeCount = edgeVertices.size() / 2;
+    cameraData->edgeGrid.reset(minX, minY, maxX, maxY, edgeCount);
+    for(size_t i = 0; i < edgeCount; ++i)
+    {
+        const int v1 = edgeVertices[2 * i];
+        const int v2 = edgeVertices[2 * i + 1];
+        cameraData->edgeGrid.insert(i, std::min(xs[v1], xs[v2]), std::min(ys[v1], ys[v2]),
+                                    std::max(xs[v1], xs[v2]), std::max(ys[v1], ys[v2]));
+    }
+
+    // Blind data (clicked positions are already in camera space)
+    const MVGObservationTable& observations = meshData.observations;
+    int blindDataCount = 0;
+    for(int i = 0; i < observations.size(); ++i)
     {
-        // Add new camera
-        std::map<int, MPoint>& cameraSpacePoints = vertexIt->cameraSpacePoints;
-        cameraSpacePoints[cameraID] =
-            MVGGeometryUtil::worldToCameraSpace(view, vertexIt->worldPosition);
+        if(observations[i].cameraId == cameraID)
+            ++blindDataCount;
+    }
+    cameraData->blindDataGrid.reset(minX, minY, maxX, maxY, blindDataCount);
+    for(int i = 0; i < observations.size(); ++i)
+    {
+        const MVGObservationTable::Observation& observation = observations[i];
+        if(observation.cameraId == cameraID && observation.vertexId < static_cast<int>(vertexCount))
+            cameraData->blindDataGrid.insert(observation.vertexId, observation.x, observation.y);
     }
 }
 
@@ -238,16 +356,176 @@ void MVGManipulatorCache::removeMeshCacheForCameraID(const int cameraID)
     for(std::map<std::string, MeshData>::iterator meshIt = _meshData.begin();
         meshIt != _meshData.end(); ++meshIt)
     {
-        std::vector<VertexData>& vertices = meshIt->second.vertices;
-        for(std::vector<VertexData>::iterator vertexIt = vertices.begin();
-            vertexIt != vertices.end(); ++vertexIt)
+        MeshData& meshData = meshIt->second;
+        std::map<int, int>::iterator slotIt = meshData.cameraSlots.find(cameraID);
+        if(slotIt == meshData.cameraSlots.end())
+            continue;
+        // Move the last slot in place of the removed one
+        const int slot = slotIt->second;
+        meshData.cameraSlots.erase(slotIt);
+        if(slot != static_cast<int>(meshData.cameras.size()) - 1)
+        {
+            std::swap(meshData.cameras[slot], meshData.cameras.back());
+            meshData.cameraSlots[meshData.cameras[slot].cameraID] = slot;
+        }
+        meshData.cameras.pop_back();
+    }
+}
+
+/**
+ * Update the cache of the dirty vertices only (world position and projections).
+ * Meshes whose topology changed are fully rebuilt.
+ */
+void MVGManipulatorCache::updateDirtyMeshesCache()
+{
+    // Swap to allow rebuildMeshCache to modify _dirtyVertices
+    std::map<std::string, std::set<int> > dirtyVertices;
+    dirtyVertices.swap(_dirtyVertices);
+    std::map<std::string, std::set<int> >::const_iterator dirtyIt = dirtyVertices.begin();
+    for(; dirtyIt != dirtyVertices.end(); ++dirtyIt)
+    {
+        MDagPath meshPath;
+        if(!MVGMayaUtil::getDagPathByName(dirtyIt->first.c_str(), meshPath))
+            continue;
+        std::map<std::string, MeshData>::iterator meshIt = _meshData.find(dirtyIt->first);
+        if(meshIt == _meshData.end())
+        {
+            rebuildMeshCache(meshPath);
+            continue;
+        }
+        updateMeshCacheVertices(meshPath, meshIt->second, dirtyIt->second);
+    }
+}
+
+/**
+ * Apply the changes recorded by MVGMeshWatcher since the last update : removed meshes are
+ * erased, meshes with a modified topology or transform are rebuilt and only the modified
+ * vertices of the other meshes are updated, with the blind data edits reported by the commands.
+ */
+void MVGManipulatorCache::updateChangedMeshesCache()
+{
+    MVGMeshWatcher::Changes changes;
+    MVGMeshWatcher::takeChanges(changes);
+    std::set<std::string>::const_iterator meshIt = changes.removedMeshes.begin();
+    for(; meshIt != changes.removedMeshes.end(); ++meshIt)
+        removeMeshCache(*meshIt);
+    for(meshIt = changes.dirtyMeshes.begin(); meshIt != changes.dirtyMeshes.end(); ++meshIt)
+    {
+        MDagPath meshPath;
+        if(MVGMayaUtil::getDagPathByName(meshIt->c_str(), meshPath))
+            rebuildMeshCache(meshPath);
+    }
+    std::map<std::string, std::vector<MVGMeshWatcher::ObservationEdit> >::const_iterator editIt =
+        changes.observationEdits.begin();
+    for(; editIt != changes.observationEdits.end(); ++editIt)
+    {
+        // Rebuilt and new meshes read the whole table
+        std::map<std::string, MeshData>::iterator dataIt = _meshData.find(editIt->first);
+        if(dataIt == _meshData.end() || changes.dirtyMeshes.count(editIt->first))
+            continue;
+        MVGObservationTable& observations = dataIt->second.observations;
+        for(size_t i = 0; i < editIt->second.size(); ++i)
+        {
+            observations.unsetObservations(editIt->second[i].vertexIds);
+            observations.setObservations(editIt->second[i].observations);
+        }
+    }
+    std::map<std::string, std::set<int> >::const_iterator dirtyIt =
+        changes.dirtyVertices.begin();
+    for(; dirtyIt != changes.dirtyVertices.end(); ++dirtyIt)
+    {
+        if(changes.dirtyMeshes.count(dirtyIt->first) ||
+           changes.removedMeshes.count(dirtyIt->first))
+            continue;
+        _dirtyVertices[dirtyIt->first].insert(dirtyIt->second.begin(), dirtyIt->second.end());
+    }
+    updateDirtyMeshesCache();
+}
+
+void MVGManipulatorCache::removeMeshCache(const std::string& meshName)
+{
+    MVGMeshWatcher::unwatch(meshName);
+    _dirtyVertices.erase(meshName);
+    std::map<std::string, MeshData>::iterator foundIt = _meshData.find(meshName);
+    if(foundIt == _meshData.end())
+        return;
+    _meshData.erase(foundIt);
+    // Components point to the erased data
+    const MDagPath& intersectedPath = _intersectedComponent.meshPath;
+    if(!intersectedPath.isValid() || intersectedPath.fullPathName().asChar() == meshName)
+        clearIntersectedComponent();
+    const MDagPath& selectedPath = _selectedComponent.meshPath;
+    if(!selectedPath.isValid() || selectedPath.fullPathName().asChar() == meshName)
+        clearSelectedComponent();
+}
+
+void MVGManipulatorCache::updateMeshCacheVertices(const MDagPath& path, MeshData& meshData,
+                                                  const std::set<int>& vertexIndices)
+{
+    MStatus status;
+    MFnMesh fnMesh(path, &status);
+    CHECK_RETURN(status)
+    // Topology has changed : vertex and edge data are not valid anymore
+    if(fnMesh.numVertices() != static_cast<int>(meshData.vertices.size()) ||
+       fnMesh.numEdges() != static_cast<int>(meshData.edges.size()))
+    {
+        rebuildMeshCache(path);
+        return;
+    }
+
+    // Blind data edits are already applied to meshData.observations (see updateChangedMeshesCache)
+    MPoint csPoint;
+    std::set<int>::const_iterator indexIt = vertexIndices.begin();
+    for(; indexIt != vertexIndices.end(); ++indexIt)
+    {
+        const int index = *indexIt;
+        if(index < 0 || index >= static_cast<int>(meshData.vertices.size()))
+            continue;
+        VertexData& vertex = meshData.vertices[index];
+        CHECK(fnMesh.getPoint(index, vertex.worldPosition, MSpace::kWorld))
+        // Update projections with the parameters used to build each camera data
+        std::vector<CameraData>::iterator cameraIt = meshData.cameras.begin();
+        for(; cameraIt != meshData.cameras.end(); ++cameraIt)
         {
-            std::map<int, MPoint>& cameraSpacePoints = vertexIt->cameraSpacePoints;
-            cameraSpacePoints.erase(cameraID);
+            MVGGeometryUtil::worldToCameraSpace(cameraIt->projection, vertex.worldPosition,
+                                                csPoint);
+            cameraIt->xs[index] = csPoint.x;
+            cameraIt->ys[index] = csPoint.y;
+            updateCameraDataVertex(meshData, *cameraIt, index);
         }
     }
 }
 
+/**
+ * Update acceleration structures of a camera for a modified vertex.
+ * Camera space position of the vertex must be up to date.
+ */
+void MVGManipulatorCache::updateCameraDataVertex(const MeshData& meshData, CameraData& cameraData,
+                                                 const int vertexIndex)
+{
+    const std::vector<double>& xs = cameraData.xs;
+    const std::vector<double>& ys = cameraData.ys;
+    // vertex
+    cameraData.vertexGrid.move(vertexIndex, xs[vertexIndex], ys[vertexIndex]);
+    // connected edges
+    const std::vector<int>& edgeVertices = meshData.edgeVertices;
+    for(int i = meshData.vertexEdgeOffsets[vertexIndex];
+        i < meshData.vertexEdgeOffsets[vertexIndex + 1]; ++i)
+    {
+        const int edge = meshData.vertexEdges[i];
+        const int v1 = edgeVertices[2 * edge];
+        const int v2 = edgeVertices[2 * edge + 1];
+        cameraData.edgeGrid.move(edge, std::min(xs[v1], xs[v2]), std::min(ys[v1], ys[v2]),
+                                 std::max(xs[v1], xs[v2]), std::max(ys[v1], ys[v2]));
+    }
+    // blind data
+    MPoint blindData;
+    if(meshData.getBlindData(vertexIndex, cameraData.cameraID, blindData))
+        cameraData.blindDataGrid.move(vertexIndex, blindData.x, blindData.y);
+    else
+        cameraData.blindDataGrid.remove(vertexIndex);
+}
+
 void MVGManipulatorCache::setSelectedComponent(const MVGComponent& selectedComponent)
 {
     _selectedComponent = selectedComponent;
@@ -277,6 +555,7 @@ void MVGManipulatorCache::updateSelectedComponent(const MDagPath& meshPath, cons
         std::vector<VertexData>& verticesArray = _meshData[meshPathString].vertices;
         if(verticesArray.size() <= index)
             return;
+        component.meshData = &it->second;
         component.vertex = &(verticesArray[index]);
     }
     _selectedComponent = component;
@@ -291,29 +570,36 @@ bool MVGManipulatorCache::isIntersectingBlindData(const double tolerance,
     const double threshold =
         (tolerance * _activeCamera.getZoom()) / (double)_activeView.portWidth();
     const int cameraID = _activeCamera.getId();
+    const double mouseX = mouseCSPosition.x;
+    const double mouseY = mouseCSPosition.y;
     // check each mesh vertices
     std::map<std::string, MeshData>::iterator meshIt = _meshData.begin();
     for(; meshIt != _meshData.end(); ++meshIt)
     {
-        std::vector<VertexData>& vertices = meshIt->second.vertices;
-        std::vector<VertexData>::iterator vertexIt = vertices.begin();
-        for(; vertexIt < vertices.end(); ++vertexIt)
+        // Blind data arrays are built along with cameraSpace coordinates
+        checkForCameraSpacePositions(_activeView, meshIt->second, cameraID);
+        const CameraData* cameraData = meshIt->second.getCameraData(cameraID);
+        if(!cameraData)
+            continue;
+        // retrieve candidates (sorted by vertex index) in the tolerance box
+        cameraData->blindDataGrid.query(mouseX - threshold, mouseY - threshold,
+                                        mouseX + threshold, mouseY + threshold, _gridCandidates);
+        MPoint blindData;
+        for(size_t i = 0; i < _gridCandidates.size(); ++i)
         {
-            std::map<int, MPoint>::const_iterator blindDataIt = vertexIt->blindData.find(cameraID);
-            if(blindDataIt == vertexIt->blindData.end())
+            const int candidate = _gridCandidates[i];
+            if(!meshIt->second.getBlindData(candidate, cameraID, blindData))
                 continue;
-            MPoint pointCSPosition = blindDataIt->second;
             // check if we intersect w/ the vertex position
-            if(mouseCSPosition.x <= pointCSPosition.x + threshold &&
-               mouseCSPosition.x >= pointCSPosition.x - threshold &&
-               mouseCSPosition.y <= pointCSPosition.y + threshold &&
-               mouseCSPosition.y >= pointCSPosition.y - threshold)
+            if(mouseX <= blindData.x + threshold && mouseX >= blindData.x - threshold &&
+               mouseY <= blindData.y + threshold && mouseY >= blindData.y - threshold)
             {
                 MDagPath meshPath;
                 MVGMayaUtil::getDagPathByName(meshIt->first.c_str(), meshPath);
                 _intersectedComponent.type = MFn::kBlindData;
                 _intersectedComponent.meshPath = meshPath;
-                _intersectedComponent.vertex = &(*vertexIt);
+                _intersectedComponent.meshData = &meshIt->second;
+                _intersectedComponent.vertex = &meshIt->second.vertices[candidate];
                 _intersectedComponent.edge = NULL;
                 return true;
             }
@@ -330,6 +616,8 @@ bool MVGManipulatorCache::isIntersectingPoint(const double tolerance, const MPoi
     double threshold = (tolerance * _activeCamera.getZoom()) / (double)_activeView.portWidth();
 
     int cameraID = _activeCamera.getId();
+    const double mouseX = mouseCSPosition.x;
+    const double mouseY = mouseCSPosition.y;
     // check each mesh vertice
     std::map<std::string, MeshData>::iterator meshIt = _meshData.begin();
     for(; meshIt != _meshData.end(); ++meshIt)
@@ -338,23 +626,27 @@ bool MVGManipulatorCache::isIntersectingPoint(const double tolerance, const MPoi
         // We compute position only if there are not in the cache to avoid computing them all the
         // time
         checkForCameraSpacePositions(_activeView, meshIt->second, cameraID);
-
-        std::vector<VertexData>& vertices = meshIt->second.vertices;
-        std::vector<VertexData>::iterator vertexIt = vertices.begin();
-        for(; vertexIt < vertices.end(); ++vertexIt)
+        const CameraData* cameraData = meshIt->second.getCameraData(cameraID);
+        if(!cameraData)
+            continue;
+        // retrieve candidates (sorted by vertex index) in the tolerance box
+        cameraData->vertexGrid.query(mouseX - threshold, mouseY - threshold, mouseX + threshold,
+                                     mouseY + threshold, _gridCandidates);
+        const std::vector<double>& xs = cameraData->xs;
+        const std::vector<double>& ys = cameraData->ys;
+        for(size_t i = 0; i < _gridCandidates.size(); ++i)
         {
+            const int candidate = _gridCandidates[i];
             // check if we intersect w/ the real vertex position projection
-            MPoint& realCSVertexPosition = vertexIt->cameraSpacePoints[cameraID];
-            if(mouseCSPosition.x <= realCSVertexPosition.x + threshold &&
-               mouseCSPosition.x >= realCSVertexPosition.x - threshold &&
-               mouseCSPosition.y <= realCSVertexPosition.y + threshold &&
-               mouseCSPosition.y >= realCSVertexPosition.y - threshold)
+            if(mouseX <= xs[candidate] + threshold && mouseX >= xs[candidate] - threshold &&
+               mouseY <= ys[candidate] + threshold && mouseY >= ys[candidate] - threshold)
             {
                 MDagPath meshPath;
                 MVGMayaUtil::getDagPathByName(meshIt->first.c_str(), meshPath);
                 _intersectedComponent.type = MFn::kMeshVertComponent;
                 _intersectedComponent.meshPath = meshPath;
-                _intersectedComponent.vertex = &(*vertexIt);
+                _intersectedComponent.meshData = &meshIt->second;
+                _intersectedComponent.vertex = &meshIt->second.vertices[candidate];
                 _intersectedComponent.edge = NULL;
                 return true;
             }
@@ -371,6 +663,8 @@ bool MVGManipulatorCache::isIntersectingEdge(const double tolerance, const MPoin
     double threshold = (tolerance * _activeCamera.getZoom()) / (double)_activeView.portWidth();
 
     int cameraID = _activeCamera.getId();
+    const double mouseX = mouseCSPosition.x;
+    const double mouseY = mouseCSPosition.y;
     // check each mesh edges
     std::map<std::string, MeshData>::iterator meshIt = _meshData.begin();
     for(; meshIt != _meshData.end(); ++meshIt)
@@ -379,22 +673,29 @@ bool MVGManipulatorCache::isIntersectingEdge(const double tolerance, const MPoin
         // We compute position only if there are not in the cache to avoid computing them all the
         // time
         checkForCameraSpacePositions(_activeView, meshIt->second, cameraID);
-
-        std::vector<EdgeData>& edges = meshIt->second.edges;
-        std::vector<EdgeData>::iterator edgeIt = edges.begin();
-        for(; edgeIt < edges.end(); ++edgeIt)
+        const CameraData* cameraData = meshIt->second.getCameraData(cameraID);
+        if(!cameraData)
+            continue;
+        // retrieve candidates (sorted by edge index) whose bounding box is in the tolerance box
+        cameraData->edgeGrid.query(mouseX - threshold, mouseY - threshold, mouseX + threshold,
+                                   mouseY + threshold, _gridCandidates);
+        const std::vector<int>& edgeVertices = meshIt->second.edgeVertices;
+        const std::vector<double>& xs = cameraData->xs;
+        const std::vector<double>& ys = cameraData->ys;
+        for(size_t i = 0; i < _gridCandidates.size(); ++i)
         {
-            MPoint& vertex1CSPosition = edgeIt->vertex1->cameraSpacePoints[cameraID];
-            MPoint& vertex2CSPosition = edgeIt->vertex2->cameraSpacePoints[cameraID];
-            if(minimumDistanceToEdge(vertex1CSPosition, vertex2CSPosition, mouseCSPosition) <
-               threshold)
+            const int candidate = _gridCandidates[i];
+            const int v1 = edgeVertices[2 * candidate];
+            const int v2 = edgeVertices[2 * candidate + 1];
+            if(minimumDistanceToEdge(xs[v1], ys[v1], xs[v2], ys[v2], mouseX, mouseY) < threshold)
             {
                 MDagPath meshPath;
                 MVGMayaUtil::getDagPathByName(meshIt->first.c_str(), meshPath);
                 _intersectedComponent.type = MFn::kMeshEdgeComponent;
                 _intersectedComponent.meshPath = meshPath;
+                _intersectedComponent.meshData = &meshIt->second;
                 _intersectedComponent.vertex = NULL;
-                _intersectedComponent.edge = &(*edgeIt);
+                _intersectedComponent.edge = &meshIt->second.edges[candidate];
                 return true;
             }
         }
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "mayaMVG/core/MVGCamera.hpp"
+#include "mayaMVG/core/MVGGeometryUtil.hpp"
+#include "mayaMVG/geometry/MVGSpatialGrid.hpp"
+#include "mayaMVG/geometry/MVGObservationTable.hpp"
 #include <maya/MDagPath.h>
 #include <maya/MIntArray.h>
 #include <maya/MPointArray.h>
 #include <maya/M3dView.h>
 #include <map>
+#include <set>
 #include <vector>
 
 namespace mayaMVG
@@ -26,43 +30,83 @@ public:
         int index;
         int numConnectedEdges;
         MPoint worldPosition;
-        std::map<int, MPoint> blindData; // map from cameraIDs to clickedCSPositions
-        /// Map from cameraIDs to cameraSpacePositions
-        /// Only store points for the cameras used in the UI.
-        std::map<int, MPoint> cameraSpacePoints;
     };
 
+    /// Vertices of the edge are stored in MeshData::edgeVertices
     struct EdgeData
     {
         EdgeData()
             : index(-1)
-            , vertex1(NULL)
-            , vertex2(NULL)
         {
         }
         int index;
-        VertexData* vertex1;
-        VertexData* vertex2;
+    };
+
+    /// Camera space data of a mesh for one camera, stored as contiguous arrays.
+    /// Only computed for the cameras used in the UI.
+    struct CameraData
+    {
+        CameraData()
+            : cameraID(-1)
+        {
+        }
+        int cameraID;
+        MVGViewProjection projection; // used to compute (and update) camera space positions
+        // camera space positions, indexed by vertex index
+        std::vector<double> xs;
+        std::vector<double> ys;
+        // acceleration structures
+        MVGSpatialGrid vertexGrid;    // ids are vertex indices
+        MVGSpatialGrid edgeGrid;      // ids are edge indices
+        MVGSpatialGrid blindDataGrid; // ids are vertex indices, see MeshData::observations
     };
 
     struct MeshData
     {
         std::vector<VertexData> vertices;
         std::vector<EdgeData> edges;
+        std::vector<int> edgeVertices;  // 2 vertex indices per edge
+        // edges connected to vertex v: vertexEdges from index vertexEdgeOffsets[v]
+        // to vertexEdgeOffsets[v + 1] (excluded)
+        std::vector<int> vertexEdgeOffsets;
+        std::vector<int> vertexEdges;
+        MVGObservationTable observations; // clicked camera space positions of all vertices
+        std::map<int, int> cameraSlots;   // map from cameraIDs to indices in cameras
+        std::vector<CameraData> cameras;
+
+        CameraData* getCameraData(const int cameraID);
+        bool getBlindData(const int vertexIndex, const int cameraID, MPoint& csPosition) const;
+        void getBlindData(const int vertexIndex, std::map<int, MPoint>& csPositions) const;
+        int getBlindDataCount(const int vertexIndex) const;
     };
 
     struct MVGComponent
     {
         MVGComponent()
             : type(MFn::kInvalid)
+            , meshData(NULL)
             , vertex(NULL)
             , edge(NULL)
         {
         }
         MFn::Type type; // kMeshEdgeComponent, kMeshVertComponent, kBlindData
         MDagPath meshPath;
+        MeshData* meshData;
         VertexData* vertex;
         EdgeData* edge;
+
+        VertexData* getEdgeVertex1() const
+        {
+            return &meshData->vertices[meshData->edgeVertices[2 * edge->index]];
+        }
+        VertexData* getEdgeVertex2() const
+        {
+            return &meshData->vertices[meshData->edgeVertices[2 * edge->index + 1]];
+        }
+        bool getBlindData(const int cameraID, MPoint& csPosition) const
+        {
+            return meshData->getBlindData(vertex->index, cameraID, csPosition);
+        }
     };
 
 public:
@@ -89,12 +133,21 @@ public:
     void computeMeshCacheForCameraID(M3dView& view, MeshData& meshData, const int cameraID);
     void removeMeshCacheForCameraID(const int cameraID);
 
+    // incremental update
+    void updateDirtyMeshesCache();
+    void updateChangedMeshesCache();
+
     const MVGComponent& getSelectedComponent() const { return _selectedComponent; }
     void setSelectedComponent(const MVGComponent& selectedComponent);
     void clearSelectedComponent() { _selectedComponent = MVGComponent(); }
     void updateSelectedComponent(const MDagPath& meshPath, const MFn::Type type, const int index);
 
 private:
+    void removeMeshCache(const std::string& meshName);
+    void updateMeshCacheVertices(const MDagPath& path, MeshData& meshData,
+                                 const std::set<int>& vertexIndices);
+    void updateCameraDataVertex(const MeshData& meshData, CameraData& cameraData,
+                                const int vertexIndex);
     bool isIntersectingBlindData(const double, const MPoint&);
     bool isIntersectingPoint(const double, const MPoint&);
     bool isIntersectingEdge(const double, const MPoint&);
@@ -104,7 +157,10 @@ private:
     MVGCamera _activeCamera;
     MVGComponent _intersectedComponent;
     MVGComponent _selectedComponent;
-    std::map<std::string, MeshData> _meshData; // per mesh
+    std::map<std::string, MeshData> _meshData;            // per mesh
+    std::map<std::string, std::set<int> > _dirtyVertices; // per mesh
+    /// Avoid reallocations on each intersection test
+    std::vector<int> _gridCandidates;
 };
 
 } // namespace
@@ -0,0 +1,223 @@
+#include "mayaMVG/maya/context/MVGMeshWatcher.hpp"
+#include "mayaMVG/maya/context/MVGContextCmd.hpp"
+#include <maya/MFnDependencyNode.h>
+#include <maya/MPolyMessage.h>
+#include <maya/MGlobal.h>
+#include <maya/MPlug.h>
+#include <algorithm>
+
+namespace mayaMVG
+{
+
+std::map<std::string, MVGMeshWatcher::WatchedMesh> MVGMeshWatcher::_watchedMeshes;
+MVGMeshWatcher::Changes MVGMeshWatcher::_changes;
+int MVGMeshWatcher::_blockCount = 0;
+bool MVGMeshWatcher::_isUpdateQueued = false;
+
+void MVGMeshWatcher::watch(const MDagPath& meshPath)
+{
+    if(!meshPath.isValid())
+        return;
+    const std::string meshName = meshPath.fullPathName().asChar();
+    if(_watchedMeshes.count(meshName))
+        return;
+    // Map nodes are not moved, so the entry address can be given to the callbacks
+    WatchedMesh& watchedMesh = _watchedMeshes[meshName];
+    watchedMesh.name = meshName;
+    watchedMesh.path = meshPath;
+
+    MStatus status;
+    MObject node = meshPath.node();
+    MObject transform = meshPath.transform();
+    MCallbackId id =
+        MNodeMessage::addAttributeChangedCallback(node, attributeChangedCB, &watchedMesh, &status);
+    if(status)
+        watchedMesh.callbacks.append(id);
+    id = MNodeMessage::addNodeDirtyPlugCallback(node, dirtyPlugCB, &watchedMesh, &status);
+    if(status)
+        watchedMesh.callbacks.append(id);
+    id = MPolyMessage::addPolyTopologyChangedCallback(node, topologyChangedCB, &watchedMesh,
+                                                      &status);
+    if(status)
+        watchedMesh.callbacks.append(id);
+    id = MDagMessage::addWorldMatrixModifiedCallback(watchedMesh.path, worldMatrixModifiedCB,
+                                                     &watchedMesh, &status);
+    if(status)
+        watchedMesh.callbacks.append(id);
+    // Cache is indexed by full path name, which depends on the transform name too
+    id = MNodeMessage::addNameChangedCallback(node, nameChangedCB, &watchedMesh, &status);
+    if(status)
+        watchedMesh.callbacks.append(id);
+    id = MNodeMessage::addNameChangedCallback(transform, nameChangedCB, &watchedMesh, &status);
+    if(status)
+        watchedMesh.callbacks.append(id);
+}
+
+void MVGMeshWatcher::unwatch(const std::string& meshName)
+{
+    std::map<std::string, WatchedMesh>::iterator it = _watchedMeshes.find(meshName);
+    if(it == _watchedMeshes.end())
+        return;
+    if(it->second.callbacks.length() > 0)
+        MMessage::removeCallbacks(it->second.callbacks);
+    _watchedMeshes.erase(it);
+}
+
+void MVGMeshWatcher::clear()
+{
+    std::map<std::string, WatchedMesh>::iterator it = _watchedMeshes.begin();
+    for(; it != _watchedMeshes.end(); ++it)
+    {
+        if(it->second.callbacks.length() > 0)
+            MMessage::removeCallbacks(it->second.callbacks);
+    }
+    _watchedMeshes.clear();
+    _changes = Changes();
+}
+
+/**
+ * Report modified vertices. Vertex positions are updated on idle.
+ *
+ * @param meshPath : path of the modified mesh
+ * @param vertexIndices : indices of the modified vertices
+ */
+void MVGMeshWatcher::setVerticesDirty(const MDagPath& meshPath, const MIntArray& vertexIndices)
+{
+    if(!meshPath.isValid() || vertexIndices.length() == 0)
+        return;
+    std::set<int>& dirtyVertices = _changes.dirtyVertices[meshPath.fullPathName().asChar()];
+    for(unsigned int i = 0; i < vertexIndices.length(); ++i)
+        dirtyVertices.insert(vertexIndices[i]);
+    queueUpdate();
+}
+
+/**
+ * Report the blind data edited by a command. The edited vertices are marked as modified.
+ *
+ * @param meshPath : path of the modified mesh
+ * @param edit : new observations of the edited vertices
+ */
+void MVGMeshWatcher::setObservationsEdited(const MDagPath& meshPath, const ObservationEdit& edit)
+{
+    if(!meshPath.isValid() || edit.vertexIds.empty())
+        return;
+    const std::string meshName = meshPath.fullPathName().asChar();
+    _changes.observationEdits[meshName].push_back(edit);
+    std::set<int>& dirtyVertices = _changes.dirtyVertices[meshName];
+    dirtyVertices.insert(edit.vertexIds.begin(), edit.vertexIds.end());
+    queueUpdate();
+}
+
+/**
+ * Report a mesh to rebuild, for topology changes. The mesh does not need to be watched.
+ */
+void MVGMeshWatcher::setMeshDirty(const MDagPath& meshPath)
+{
+    if(!meshPath.isValid())
+        return;
+    recordChange(_changes.dirtyMeshes, meshPath.fullPathName().asChar());
+}
+
+void MVGMeshWatcher::setMeshRemoved(const MDagPath& meshPath)
+{
+    if(!meshPath.isValid())
+        return;
+    recordChange(_changes.removedMeshes, meshPath.fullPathName().asChar());
+}
+
+/**
+ * Retrieve and reset the changes recorded since the last call.
+ */
+void MVGMeshWatcher::takeChanges(Changes& changes)
+{
+    changes = Changes();
+    std::swap(changes, _changes);
+    _isUpdateQueued = false;
+}
+
+void MVGMeshWatcher::queueUpdate()
+{
+    if(_isUpdateQueued)
+        return;
+    _isUpdateQueued = true;
+    // Without context, changes are kept until its cache is built (see rebuildMeshesCache)
+    MString cmd;
+    cmd.format("if(`contextInfo -exists ^2s`) ^1s -e -update ^2s", MVGContextCmd::name,
+               MVGContextCmd::instanceName);
+    MGlobal::executeCommandOnIdle(cmd);
+}
+
+void MVGMeshWatcher::recordChange(std::set<std::string>& meshes, const std::string& meshName)
+{
+    meshes.insert(meshName);
+    queueUpdate();
+}
+
+void MVGMeshWatcher::attributeChangedCB(MNodeMessage::AttributeMessage msg, MPlug& plug,
+                                        MPlug& /*otherPlug*/, void* watchedMesh)
+{
+    if(_blockCount > 0)
+        return;
+    const WatchedMesh* mesh = static_cast<const WatchedMesh*>(watchedMesh);
+    MFnDependencyNode fn(plug.node());
+    if(msg & MNodeMessage::kAttributeSet)
+    {
+        // Vertex tweak : pnts[i] or one of its children
+        MPlug elementPlug = plug.isChild() ? plug.parent() : plug;
+        if(elementPlug.isElement() && elementPlug.attribute() == fn.attribute("pnts"))
+        {
+            std::set<int>& dirtyVertices = _changes.dirtyVertices[mesh->name];
+            dirtyVertices.insert(elementPlug.logicalIndex());
+            queueUpdate();
+            return;
+        }
+        // Blind data or activation (see MVGMesh)
+        if(plug.attribute() == fn.attribute("mvgObservations") ||
+           plug.attribute() == fn.attribute("mvg"))
+            recordChange(_changes.dirtyMeshes, mesh->name);
+        return;
+    }
+    // Construction history added or removed
+    if((msg & (MNodeMessage::kConnectionMade | MNodeMessage::kConnectionBroken)) &&
+       plug.attribute() == fn.attribute("inMesh"))
+        recordChange(_changes.dirtyMeshes, mesh->name);
+}
+
+void MVGMeshWatcher::dirtyPlugCB(MObject& node, MPlug& plug, void* watchedMesh)
+{
+    if(_blockCount > 0)
+        return;
+    // Upstream construction history has changed
+    MFnDependencyNode fn(node);
+    if(plug.attribute() == fn.attribute("inMesh"))
+        recordChange(_changes.dirtyMeshes, static_cast<const WatchedMesh*>(watchedMesh)->name);
+}
+
+void MVGMeshWatcher::topologyChangedCB(MObject& /*node*/, void* watchedMesh)
+{
+    if(_blockCount > 0)
+        return;
+    recordChange(_changes.dirtyMeshes, static_cast<const WatchedMesh*>(watchedMesh)->name);
+}
+
+void MVGMeshWatcher::worldMatrixModifiedCB(MObject& /*transformNode*/,
+                                           MDagMessage::MatrixModifiedFlags& /*modified*/,
+                                           void* watchedMesh)
+{
+    if(_blockCount > 0)
+        return;
+    // All world positions have changed
+    recordChange(_changes.dirtyMeshes, static_cast<const WatchedMesh*>(watchedMesh)->name);
+}
+
+void MVGMeshWatcher::nameChangedCB(MObject& /*node*/, const MString& /*previousName*/,
+                                   void* watchedMesh)
+{
+    // Not blocked : the cache entry must follow the new name whoever renamed the mesh
+    const WatchedMesh* mesh = static_cast<const WatchedMesh*>(watchedMesh);
+    recordChange(_changes.removedMeshes, mesh->name);
+    if(mesh->path.isValid())
+        recordChange(_changes.dirtyMeshes, mesh->path.fullPathName().asChar());
+}
+
+} // namespace
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "mayaMVG/geometry/MVGObservationTable.hpp"
+#include <maya/MDagPath.h>
+#include <maya/MIntArray.h>
+#include <maya/MCallbackIdArray.h>
+#include <maya/MNodeMessage.h>
+#include <maya/MDagMessage.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace mayaMVG
+{
+
+/**
+ * Records which meshes cached by the manipulators were modified, and which of their vertices.
+ * Callbacks are registered on each active mesh when it is cached (see MVGManipulatorCache).
+ * Changes are accumulated and applied to the cache on idle, through the -update flag of the
+ * context command, so that undo/redo and external edits only refresh what they touched.
+ * Changes made by MayaMVG commands are reported explicitly, with watching suspended meanwhile.
+ * Their blind data edits are reported too, so that the cache doesn't read the whole table again.
+ */
+class MVGMeshWatcher
+{
+public:
+    /// New observations of some vertices, replacing all their former ones
+    struct ObservationEdit
+    {
+        std::vector<int> vertexIds;
+        std::vector<MVGObservationTable::Observation> observations;
+    };
+
+    struct Changes
+    {
+        std::map<std::string, std::set<int> > dirtyVertices;                   // per mesh
+        std::map<std::string, std::vector<ObservationEdit> > observationEdits; // per mesh, in order
+        std::set<std::string> dirtyMeshes;                                     // to rebuild
+        std::set<std::string> removedMeshes;
+    };
+
+    /// Suspend watching for the lifetime of the object
+    class Blocker
+    {
+    public:
+        Blocker() { ++_blockCount; }
+        ~Blocker() { --_blockCount; }
+    };
+
+public:
+    static void watch(const MDagPath& meshPath);
+    static void unwatch(const std::string& meshName);
+    static void clear();
+
+    static void setVerticesDirty(const MDagPath& meshPath, const MIntArray& vertexIndices);
+    static void setObservationsEdited(const MDagPath& meshPath, const ObservationEdit& edit);
+    static void setMeshDirty(const MDagPath& meshPath);
+    static void setMeshRemoved(const MDagPath& meshPath);
+    static void takeChanges(Changes& changes);
+
+private:
+    struct WatchedMesh
+    {
+        std::string name; // full path name when watching started
+        MDagPath path;
+        MCallbackIdArray callbacks;
+    };
+
+    static void queueUpdate();
+    static void attributeChangedCB(MNodeMessage::AttributeMessage msg, MPlug& plug,
+                                   MPlug& otherPlug, void* watchedMesh);
+    static void dirtyPlugCB(MObject& node, MPlug& plug, void* watchedMesh);
+    static void topologyChangedCB(MObject& node, void* watchedMesh);
+    static void worldMatrixModifiedCB(MObject& transformNode,
+                                      MDagMessage::MatrixModifiedFlags& modified,
+                                      void* watchedMesh);
+    static void nameChangedCB(MObject& node, const MString& previousName, void* watchedMesh);
+    static void recordChange(std::set<std::string>& meshes, const std::string& meshName);
+
+private:
+    static std::map<std::string, WatchedMesh> _watchedMeshes; // per mesh
+    static Changes _changes;
+    static int _blockCount;
+    static bool _isUpdateQueued;
+};
+
+} // namespace
@@ -1,5 +1,6 @@
 #include "mayaMVG/maya/context/MVGMoveManipulator.hpp"
 #include "mayaMVG/maya/context/MVGDrawUtil.hpp"
+#include "mayaMVG/maya/context/MVGMeshWatcher.hpp"
 #include "mayaMVG/maya/MVGMayaUtil.hpp"
 #include "mayaMVG/core/MVGGeometryUtil.hpp"
 #include "mayaMVG/core/MVGMesh.hpp"
@@ -77,12 +78,12 @@ void MVGMoveManipulator::draw(M3dView& view, const MDagPath& path, M3dView::Disp
             onPressIntersectedWSPoints.append(_onPressIntersectedComponent.vertex->worldPosition);
             break;
         case MFn::kMeshEdgeComponent:
-            getIntermediateCSEdgePoints(view, _onPressIntersectedComponent.edge, _onPressCSPoint,
+            getIntermediateCSEdgePoints(view, _onPressIntersectedComponent, _onPressCSPoint,
                                         intermediateIntersectedCSPoints);
             onPressIntersectedWSPoints.append(
-                _onPressIntersectedComponent.edge->vertex1->worldPosition);
+                _onPressIntersectedComponent.getEdgeVertex1()->worldPosition);
             onPressIntersectedWSPoints.append(
-                _onPressIntersectedComponent.edge->vertex2->worldPosition);
+                _onPressIntersectedComponent.getEdgeVertex2()->worldPosition);
             break;
         default:
             break;
@@ -175,8 +176,10 @@ MStatus MVGMoveManipulator::doPress(M3dView& view)
     if(_cache->getActiveCamera().getId() != _cameraID)
     {
         _cameraID = _cache->getActiveCamera().getId();
-        _cache->getActiveCamera().getVisibleItems(_visiblePointCloudItems);
+        _cache->getActiveCamera().getVisibleIndexes(_visiblePointCloudIndexes);
     }
+    // built again on the first projection of this press (view or point cloud may have changed)
+    _visiblePointsGrid.clear();
 
     // set this view as the active view
     _cache->setActiveView(view);
@@ -226,9 +229,8 @@ MStatus MVGMoveManipulator::doRelease(M3dView& view)
        selectedComponent.type == MFn::kBlindData)
     {
         // Compute triangulated point with mouse position only if point is not already placed in 2D
-        std::map<int, MPoint>::const_iterator currentData =
-            selectedComponent.vertex->blindData.find(camera.getId());
-        if(currentData == selectedComponent.vertex->blindData.end())
+        MPoint blindData;
+        if(!selectedComponent.getBlindData(camera.getId(), blindData))
             _onPressIntersectedComponent = selectedComponent;
     }
     if(_onPressIntersectedComponent.type == MFn::kInvalid) // not moving a component
@@ -260,10 +262,10 @@ MStatus MVGMoveManipulator::doRelease(M3dView& view)
         }
         case MFn::kMeshEdgeComponent:
         {
-            indices.append(_onPressIntersectedComponent.edge->vertex1->index);
-            indices.append(_onPressIntersectedComponent.edge->vertex2->index);
+            indices.append(_onPressIntersectedComponent.getEdgeVertex1()->index);
+            indices.append(_onPressIntersectedComponent.getEdgeVertex2()->index);
             if(_mode == eMoveModeNViewTriangulation)
-                getIntermediateCSEdgePoints(view, _onPressIntersectedComponent.edge,
+                getIntermediateCSEdgePoints(view, _onPressIntersectedComponent,
                                             _onPressCSPoint, clickedCSPoints);
             break;
         }
@@ -296,7 +298,8 @@ MStatus MVGMoveManipulator::doRelease(M3dView& view)
         if(cmd->doIt(args))
         {
             cmd->finalize();
-            _cache->rebuildMeshCache(_onPressIntersectedComponent.meshPath);
+            // Only update the moved vertices, reported by the command
+            _cache->updateChangedMeshesCache();
         }
     }
 
@@ -354,14 +357,15 @@ MStatus MVGMoveManipulator::doDrag(M3dView& view)
             verticesID.append(_onPressIntersectedComponent.vertex->index);
             break;
         case MFn::kMeshEdgeComponent:
-            verticesID.append(_onPressIntersectedComponent.edge->vertex1->index);
-            verticesID.append(_onPressIntersectedComponent.edge->vertex2->index);
+            verticesID.append(_onPressIntersectedComponent.getEdgeVertex1()->index);
+            verticesID.append(_onPressIntersectedComponent.getEdgeVertex2()->index);
             break;
     }
 
     computeFinalWSPoints(view);
 
-    // Set points
+    // Set points (preview only, the cache is updated on release)
+    MVGMeshWatcher::Blocker blocker;
     if(_finalWSPoints.length() > 0)
     {
         MVGMesh mesh(_onPressIntersectedComponent.meshPath);
@@ -415,7 +419,8 @@ void MVGMoveManipulator::computeTriangulatedPoints(M3dView& view, MPointArray& f
         {
             intermediateCSPositions.append(getMousePosition(view));
             MPoint triangulatedWSPoint;
-            if(triangulate(view, _onPressIntersectedComponent.vertex, intermediateCSPositions[0],
+            if(triangulate(view, *_onPressIntersectedComponent.meshData,
+                           _onPressIntersectedComponent.vertex->index, intermediateCSPositions[0],
                            triangulatedWSPoint))
                 finalWSPoints.append(triangulatedWSPoint);
             break;
@@ -426,15 +431,17 @@ void MVGMoveManipulator::computeTriangulatedPoints(M3dView& view, MPointArray& f
             MPoint triangulatedWSPoint;
             bool isVertex1Computed = false;
             bool isVertex2Computed = false;
-            getIntermediateCSEdgePoints(view, _onPressIntersectedComponent.edge, _onPressCSPoint,
+            getIntermediateCSEdgePoints(view, _onPressIntersectedComponent, _onPressCSPoint,
                                         intermediateCSPositions);
-            if(triangulate(view, _onPressIntersectedComponent.edge->vertex1,
+            if(triangulate(view, *_onPressIntersectedComponent.meshData,
+                           _onPressIntersectedComponent.getEdgeVertex1()->index,
                            intermediateCSPositions[0], triangulatedWSPoint))
             {
                 isVertex1Computed = true;
                 finalWSPoints.append(triangulatedWSPoint);
             }
-            if(triangulate(view, _onPressIntersectedComponent.edge->vertex2,
+            if(triangulate(view, *_onPressIntersectedComponent.meshData,
+                           _onPressIntersectedComponent.getEdgeVertex2()->index,
                            intermediateCSPositions[1], triangulatedWSPoint))
             {
                 isVertex2Computed = true;
@@ -443,8 +450,8 @@ void MVGMoveManipulator::computeTriangulatedPoints(M3dView& view, MPointArray& f
             // in case we can move only one vertex
             if(finalWSPoints.length() == 1)
             {
-                MVector edgeWS = _onPressIntersectedComponent.edge->vertex2->worldPosition -
-                                 _onPressIntersectedComponent.edge->vertex1->worldPosition;
+                MVector edgeWS = _onPressIntersectedComponent.getEdgeVertex2()->worldPosition -
+                                 _onPressIntersectedComponent.getEdgeVertex1()->worldPosition;
                 if(isVertex1Computed)
                     finalWSPoints.append(finalWSPoints[0] + edgeWS);
                 if(isVertex2Computed)
@@ -502,8 +509,8 @@ void MVGMoveManipulator::computePCPoints(M3dView& view, MPointArray& finalWSPoin
             assert(movingVertexIDInThisFace != -1);
             MPointArray worldSpacePoints;
             MVGPointCloud cloud(MVGProject::_CLOUD);
-            if(cloud.projectPoints(view, _visiblePointCloudItems, cameraSpacePoints,
-                                   worldSpacePoints))
+            if(cloud.projectPoints(view, _visiblePointCloudIndexes, _visiblePointsGrid,
+                                   cameraSpacePoints, worldSpacePoints))
             {
                 // add only the moved vertex position, not the other projected vertices
                 finalWSPoints.append(worldSpacePoints[movingVertexIDInThisFace]);
@@ -523,18 +530,18 @@ void MVGMoveManipulator::computePCPoints(M3dView& view, MPointArray& finalWSPoin
                 return;
             MIntArray verticesIDs = mesh.getFaceVertices(connectedFacesIDs[0]);
             MPointArray intermediateCSPositions;
-            getIntermediateCSEdgePoints(view, _onPressIntersectedComponent.edge, _onPressCSPoint,
+            getIntermediateCSEdgePoints(view, _onPressIntersectedComponent, _onPressCSPoint,
                                         intermediateCSPositions);
             MPointArray cameraSpacePoints;
             // replace the moved edge position
             for(size_t i = 0; i < verticesIDs.length(); ++i)
             {
-                if(verticesIDs[i] == _onPressIntersectedComponent.edge->vertex1->index)
+                if(verticesIDs[i] == _onPressIntersectedComponent.getEdgeVertex1()->index)
                 {
                     cameraSpacePoints.append(intermediateCSPositions[0]);
                     continue;
                 }
-                if(verticesIDs[i] == _onPressIntersectedComponent.edge->vertex2->index)
+                if(verticesIDs[i] == _onPressIntersectedComponent.getEdgeVertex2()->index)
                 {
                     cameraSpacePoints.append(intermediateCSPositions[1]);
                     continue;
@@ -547,14 +554,17 @@ void MVGMoveManipulator::computePCPoints(M3dView& view, MPointArray& finalWSPoin
             MPoint projectedMouseWS;
             MVGPointCloud cloud(MVGProject::_CLOUD);
             MPointArray constraintedWSPoints;
-            constraintedWSPoints.append(_onPressIntersectedComponent.edge->vertex1->worldPosition);
-            constraintedWSPoints.append(_onPressIntersectedComponent.edge->vertex2->worldPosition);
-            if(cloud.projectPointsWithLineConstraint(view, _visiblePointCloudItems,
-                                                     cameraSpacePoints, constraintedWSPoints,
+            constraintedWSPoints.append(
+                _onPressIntersectedComponent.getEdgeVertex1()->worldPosition);
+            constraintedWSPoints.append(
+                _onPressIntersectedComponent.getEdgeVertex2()->worldPosition);
+            if(cloud.projectPointsWithLineConstraint(view, _visiblePointCloudIndexes,
+                                                     _visiblePointsGrid, cameraSpacePoints,
+                                                     constraintedWSPoints,
                                                      getMousePosition(view), projectedMouseWS))
             {
                 MPointArray translatedWSEdgePoints;
-                getTranslatedWSEdgePoints(view, _onPressIntersectedComponent.edge, _onPressCSPoint,
+                getTranslatedWSEdgePoints(view, _onPressIntersectedComponent, _onPressCSPoint,
                                           projectedMouseWS, translatedWSEdgePoints);
                 // add only the moved vertices positions, not the other projected vertices
                 finalWSPoints.append(translatedWSEdgePoints[0]);
@@ -638,7 +648,7 @@ void MVGMoveManipulator::computeAdjacentPoints(M3dView& view, MPointArray& final
                                                       projectedWSPoints))
                 return;
             MPointArray translatedWSEdgePoints;
-            getTranslatedWSEdgePoints(view, _onPressIntersectedComponent.edge, _onPressCSPoint,
+            getTranslatedWSEdgePoints(view, _onPressIntersectedComponent, _onPressCSPoint,
                                       projectedWSPoints[0], translatedWSEdgePoints);
             // add only the moved vertices positions, not the other projected vertices
             finalWSPoints.append(translatedWSEdgePoints[0]);
@@ -696,6 +706,7 @@ MStatus MVGMoveManipulator::resetTweakInformation()
 {
     if(_onPressIntersectedComponent.type == MFn::kInvalid)
         return MS::kFailure;
+    MVGMeshWatcher::Blocker blocker;
     // Retrieve tweak information
     MStatus status;
     MDagPath meshPath = _onPressIntersectedComponent.meshPath;
@@ -726,12 +737,14 @@ MStatus MVGMoveManipulator::resetTweakInformation()
     return status;
 }
 
-bool MVGMoveManipulator::triangulate(M3dView& view, MVGManipulatorCache::VertexData* vertex,
+bool MVGMoveManipulator::triangulate(M3dView& view, const MVGManipulatorCache::MeshData& meshData,
+                                     const int vertexIndex,
                                      const MPoint& currentVertexPositionsInActiveView,
                                      MPoint& triangulatedWSPoint)
 {
     // retrieve blind data
-    std::map<int, MPoint> blindData = vertex->blindData;
+    std::map<int, MPoint> blindData;
+    meshData.getBlindData(vertexIndex, blindData);
     // override blind data for the active camera
     blindData[_cache->getActiveCamera().getId()] = currentVertexPositionsInActiveView;
     if(blindData.size() < 2)
@@ -780,16 +793,16 @@ void MVGMoveManipulator::drawPlacedPoints(
     std::map<std::string, MVGManipulatorCache::MeshData>::const_iterator it = meshData.begin();
     for(; it != meshData.end(); ++it)
     {
-        // browse vertices
+        // browse blind data of the camera
         const std::vector<MVGManipulatorCache::VertexData>& vertices = it->second.vertices;
-        for(std::vector<MVGManipulatorCache::VertexData>::const_iterator verticesIt =
-                vertices.begin();
-            verticesIt != vertices.end(); ++verticesIt)
+        const MVGObservationTable& observations = it->second.observations;
+        for(int i = 0; i < observations.size(); ++i)
         {
-            std::map<int, MPoint>::const_iterator currentData =
-                verticesIt->blindData.find(camera.getId());
-            if(currentData == verticesIt->blindData.end())
+            const MVGObservationTable::Observation& observation = observations[i];
+            if(observation.cameraId != camera.getId() ||
+               observation.vertexId >= static_cast<int>(vertices.size()))
                 continue;
+            const MVGManipulatorCache::VertexData& vertex = vertices[observation.vertexId];
 
             // Don't draw if point is currently moving //in the current view
             if(onPressIntersectedComponent.meshPath.fullPathName().asChar() == it->first)
@@ -798,29 +811,29 @@ void MVGMoveManipulator::drawPlacedPoints(
                    (onPressIntersectedComponent.type == MFn::kBlindData &&
                     _mode == eMoveModeNViewTriangulation))
                 {
-                    if(onPressIntersectedComponent.vertex->index == verticesIt->index)
+                    if(onPressIntersectedComponent.vertex->index == vertex.index)
                         continue;
                 }
                 if(onPressIntersectedComponent.type == MFn::kMeshEdgeComponent)
                 {
-                    if(onPressIntersectedComponent.edge->vertex1->index == verticesIt->index)
+                    if(onPressIntersectedComponent.getEdgeVertex1()->index == vertex.index)
                         continue;
-                    if(onPressIntersectedComponent.edge->vertex2->index == verticesIt->index)
+                    if(onPressIntersectedComponent.getEdgeVertex2()->index == vertex.index)
                         continue;
                 }
             }
 
             // 2D position
-            MPoint clickedVSPoint =
-                MVGGeometryUtil::cameraToViewSpace(view, verticesIt->blindData.at(camera.getId()));
+            MPoint clickedVSPoint = MVGGeometryUtil::cameraToViewSpace(
+                view, MPoint(observation.x, observation.y));
             MVGDrawUtil::drawFullCross(clickedVSPoint, 7, 1, MVGDrawUtil::_triangulateColor);
             // Link between 2D/3D positions
-            MPoint vertexVS = MVGGeometryUtil::worldToViewSpace(view, verticesIt->worldPosition);
+            MPoint vertexVS = MVGGeometryUtil::worldToViewSpace(view, vertex.worldPosition);
             MVGDrawUtil::drawLine2D(clickedVSPoint, vertexVS, MVGDrawUtil::_triangulateColor, 1.5f,
                                     1.f, true);
             // Number of placed points
             MString nbView;
-            nbView += (int)(verticesIt->blindData.size());
+            nbView += it->second.getBlindDataCount(observation.vertexId);
             view.setDrawColor(MColor(0.9f, 0.3f, 0.f));
             view.drawText(nbView,
                           MVGGeometryUtil::viewToWorldSpace(view, clickedVSPoint + MPoint(5, 5)));
@@ -843,11 +856,10 @@ void MVGMoveManipulator::drawComplementaryIntersectedBlindData(
     if(!camera.isValid())
         return;
 
-    const std::map<int, MPoint>::const_iterator it =
-        intersectedComponent.vertex->blindData.find(camera.getId());
-    if(it != intersectedComponent.vertex->blindData.end())
+    MPoint blindData;
+    if(intersectedComponent.getBlindData(camera.getId(), blindData))
     {
-        MPoint intersectedVSPoint = MVGGeometryUtil::cameraToViewSpace(view, it->second);
+        MPoint intersectedVSPoint = MVGGeometryUtil::cameraToViewSpace(view, blindData);
         MVGDrawUtil::drawEmptyCross(intersectedVSPoint, 8, 2, MVGDrawUtil::_intersectionColor, 1.5);
     }
 }
@@ -868,15 +880,16 @@ void MVGMoveManipulator::drawVertexOnHover(M3dView& view, MVGManipulatorCache* c
     if(!cache->getActiveCamera().isValid())
         return;
     const int cameraID = cache->getActiveCamera().getId();
-    std::map<int, MPoint> intersectedBD;
+    const MVGManipulatorCache::MeshData* meshData = intersectedComponent.meshData;
+    MPoint blindData;
     switch(intersectedComponent.type)
     {
         case MFn::kMeshVertComponent:
         {
-            intersectedBD = intersectedComponent.vertex->blindData;
-            if(intersectedBD.find(cameraID) != intersectedBD.end())
+            const int vertexIndex = intersectedComponent.vertex->index;
+            if(meshData->getBlindData(vertexIndex, cameraID, blindData))
                 break;
-            nbView += (int)(intersectedBD.size());
+            nbView += meshData->getBlindDataCount(vertexIndex);
             view.setDrawColor(MVGDrawUtil::_placedInOtherViewColor);
             view.drawText(
                 nbView, MVGGeometryUtil::viewToWorldSpace(view, mouseVSPosition + MPoint(12, 12)));
@@ -884,20 +897,20 @@ void MVGMoveManipulator::drawVertexOnHover(M3dView& view, MVGManipulatorCache* c
         }
         case MFn::kMeshEdgeComponent:
         {
-            intersectedBD = intersectedComponent.edge->vertex1->blindData;
-            if(intersectedBD.find(cameraID) == intersectedBD.end())
+            const int vertex1Index = intersectedComponent.getEdgeVertex1()->index;
+            if(!meshData->getBlindData(vertex1Index, cameraID, blindData))
             {
-                nbView += (int)(intersectedBD.size());
+                nbView += meshData->getBlindDataCount(vertex1Index);
                 view.setDrawColor(MVGDrawUtil::_placedInOtherViewColor);
-                view.drawText(nbView, intersectedComponent.edge->vertex1->worldPosition);
+                view.drawText(nbView, intersectedComponent.getEdgeVertex1()->worldPosition);
             }
-            intersectedBD = intersectedComponent.edge->vertex2->blindData;
-            if(intersectedBD.find(cameraID) == intersectedBD.end())
+            const int vertex2Index = intersectedComponent.getEdgeVertex2()->index;
+            if(!meshData->getBlindData(vertex2Index, cameraID, blindData))
             {
                 nbView.clear();
-                nbView += (int)(intersectedBD.size());
+                nbView += meshData->getBlindDataCount(vertex2Index);
                 view.setDrawColor(MVGDrawUtil::_placedInOtherViewColor);
-                view.drawText(nbView, intersectedComponent.edge->vertex2->worldPosition);
+                view.drawText(nbView, intersectedComponent.getEdgeVertex2()->worldPosition);
             }
             break;
         }
@@ -917,11 +930,10 @@ MVGMoveManipulator::drawSelectedPoint2D(M3dView& view, const MVGCamera& camera,
     if(selectedComponent.type != MFn::kMeshVertComponent &&
        selectedComponent.type != MFn::kBlindData)
         return;
-    std::map<int, MPoint>::const_iterator currentData =
-        selectedComponent.vertex->blindData.find(camera.getId());
-    if(currentData != selectedComponent.vertex->blindData.end())
+    MPoint blindData;
+    if(selectedComponent.getBlindData(camera.getId(), blindData))
     {
-        MPoint blindDataVS = MVGGeometryUtil::cameraToViewSpace(view, currentData->second);
+        MPoint blindDataVS = MVGGeometryUtil::cameraToViewSpace(view, blindData);
         MVGDrawUtil::drawEmptyCross(blindDataVS, 8, 2, MVGDrawUtil::_selectionColor, 1.5);
     }
 }
@@ -963,11 +975,9 @@ MVGMoveManipulator::drawPointToBePlaced(M3dView& view, const MVGCamera& camera,
        selectedComponent.type != MFn::kBlindData)
         return;
 
-    std::map<int, MPoint>::const_iterator currentData =
-        selectedComponent.vertex->blindData.find(camera.getId());
-
     // Only draw if no blind data for the current view
-    if(currentData != selectedComponent.vertex->blindData.end())
+    MPoint blindData;
+    if(selectedComponent.getBlindData(camera.getId(), blindData))
         return;
 
     MVGDrawUtil::drawFullCross(mouseVSPosition, 7, 1, MVGDrawUtil::_selectionColor);
@@ -38,8 +38,9 @@ private:
     void computeAdjacentPoints(M3dView& view, MPointArray& finalWSPoints);
     MStatus storeTweakInformation();
     MStatus resetTweakInformation();
-    bool triangulate(M3dView& view, MVGManipulatorCache::VertexData* vertex,
-                     const MPoint& currentVertexPositionsInActiveView, MPoint& triangulatedWSPoint);
+    bool triangulate(M3dView& view, const MVGManipulatorCache::MeshData& meshData,
+                     const int vertexIndex, const MPoint& currentVertexPositionsInActiveView,
+                     MPoint& triangulatedWSPoint);
 
 public:
     static void drawCursor(const MPoint& originVS);
@@ -15,6 +15,7 @@ namespace mayaMVG
 {
 
 MVGMeshEditFactory::MVGMeshEditFactory()
+    : _legacyBD(false)
 {
     _componentIDs.clear();
 }
@@ -54,6 +55,11 @@ void MVGMeshEditFactory::setClearBlindData(const bool clear)
     _clearBD = clear;
 }
 
+void MVGMeshEditFactory::setLegacyBlindData(const bool legacy)
+{
+    _legacyBD = legacy;
+}
+
 void MVGMeshEditFactory::setEditType(const EditType type)
 {
     _editType = type;
@@ -89,27 +95,29 @@ MStatus MVGMeshEditFactory::doIt()
             // move
             if(_componentIDs.length() == _worldPositions.length())
             {
-                for(size_t i = 0; i < _componentIDs.length(); ++i)
+                CHECK(mesh.setPoints(_componentIDs, _worldPositions))
+                if(_legacyBD && _clearBD)
                 {
-                    CHECK(mesh.setPoint(_componentIDs[i], _worldPositions[i]))
-                    if(_clearBD)
-                        CHECK(mesh.unsetBlindData(_componentIDs[i]));
+                    for(size_t i = 0; i < _componentIDs.length(); ++i)
+                        CHECK(mesh.unsetLegacyBlindData(_componentIDs[i]));
                 }
             }
-            if(!_clearBD)
+            // Blind data are now stored on the mesh node by MVGEditCmd
+            if(_legacyBD && !_clearBD)
             {
-                // set blind data
                 assert(_componentIDs.length() == _cameraPositions.length());
                 for(size_t i = 0; i < _componentIDs.length(); ++i)
-                    CHECK(mesh.setBlindDataPerCamera(_componentIDs[i], _cameraID,
-                                                     _cameraPositions[i]))
+                    CHECK(mesh.setLegacyBlindDataPerCamera(_componentIDs[i], _cameraID,
+                                                           _cameraPositions[i]))
             }
             break;
         }
         case kClearBD:
         {
+            if(!_legacyBD)
+                break;
             for(size_t i = 0; i < _componentIDs.length(); ++i)
-                CHECK(mesh.unsetBlindData(_componentIDs[i]));
+                CHECK(mesh.unsetLegacyBlindData(_componentIDs[i]));
             break;
         }
     }
@@ -33,6 +33,7 @@ public:
     void setCameraPositions(const MPointArray& cameraPositions);
     void setCameraID(const int cameraID);
     void setClearBlindData(const bool clear);
+    void setLegacyBlindData(const bool legacy);
     void setEditType(const EditType type);
 
 public:
@@ -46,6 +47,7 @@ private:
     MPointArray _cameraPositions;
     int _cameraID;
     bool _clearBD;
+    bool _legacyBD; // write per-vertex blind data, as edit nodes of previous versions did
     EditType _editType;
 };
 
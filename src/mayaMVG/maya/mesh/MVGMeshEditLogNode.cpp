@@ -0,0 +1,317 @@
+#include "mayaMVG/maya/mesh/MVGMeshEditLogNode.hpp"
+#include "mayaMVG/core/MVGLog.hpp"
+#include <maya/MFnTypedAttribute.h>
+#include <maya/MFnMeshData.h>
+#include <maya/MFnMesh.h>
+#include <maya/MFnPointArrayData.h>
+#include <maya/MFnIntArrayData.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MPointArray.h>
+#include <maya/MPlug.h>
+#include <maya/MPlugArray.h>
+#include <maya/MDagPath.h>
+#include <maya/MDataBlock.h>
+#include <maya/MDataHandle.h>
+#include <algorithm>
+
+namespace mayaMVG
+{
+
+namespace
+{ // empty namespace
+
+void getIntArray(const MObject& node, const MObject& attribute, MIntArray& array)
+{
+    MObject data;
+    MPlug(node, attribute).getValue(data);
+    MFnIntArrayData arrayFn(data);
+    arrayFn.copyTo(array);
+}
+
+void getPointArray(const MObject& node, const MObject& attribute, MPointArray& array)
+{
+    MObject data;
+    MPlug(node, attribute).getValue(data);
+    MFnPointArrayData arrayFn(data);
+    arrayFn.copyTo(array);
+}
+
+MStatus setIntArray(const MObject& node, const MObject& attribute, const MIntArray& array)
+{
+    MFnIntArrayData arrayFn;
+    return MPlug(node, attribute).setValue(arrayFn.create(array));
+}
+
+MStatus setPointArray(const MObject& node, const MObject& attribute, const MPointArray& array)
+{
+    MFnPointArrayData arrayFn;
+    return MPlug(node, attribute).setValue(arrayFn.create(array));
+}
+
+} // empty namespace
+
+MTypeId MVGMeshEditLogNode::_id(0x00085001); // FIXME
+
+MObject MVGMeshEditLogNode::aInMesh;
+MObject MVGMeshEditLogNode::aInEdits;
+MObject MVGMeshEditLogNode::aInIndices;
+MObject MVGMeshEditLogNode::aInWorldPositions;
+MObject MVGMeshEditLogNode::aOutMesh;
+const int MVGMeshEditLogNode::_EDIT_HEADER_SIZE;
+int MVGMeshEditLogNode::_nextSerial = 0;
+
+MVGMeshEditLogNode::MVGMeshEditLogNode()
+    : _cachedEditCount(0)
+    , _cachedLastSerial(-1)
+    , _cachedIndexOffset(0)
+    , _cachedPositionOffset(0)
+{
+}
+
+MVGMeshEditLogNode::~MVGMeshEditLogNode()
+{
+}
+
+void* MVGMeshEditLogNode::creator()
+{
+    return new MVGMeshEditLogNode();
+}
+
+MStatus MVGMeshEditLogNode::initialize()
+{
+    MStatus status;
+    MFnTypedAttribute tAttr;
+
+    aInMesh = tAttr.create("inMesh", "im", MFnMeshData::kMesh, &status);
+    CHECK_RETURN_STATUS(status)
+    tAttr.setStorable(true);
+    CHECK_RETURN_STATUS(addAttribute(aInMesh))
+
+    aInEdits = tAttr.create("inEdits", "ied", MFnData::kIntArray, &status);
+    CHECK_RETURN_STATUS(status)
+    tAttr.setStorable(true);
+    CHECK_RETURN_STATUS(addAttribute(aInEdits))
+
+    aInIndices = tAttr.create("inIndices", "iin", MFnData::kIntArray, &status);
+    CHECK_RETURN_STATUS(status)
+    tAttr.setStorable(true);
+    CHECK_RETURN_STATUS(addAttribute(aInIndices))
+
+    aInWorldPositions = tAttr.create("inWorldPositions", "iwp", MFnData::kPointArray, &status);
+    CHECK_RETURN_STATUS(status)
+    tAttr.setStorable(true);
+    CHECK_RETURN_STATUS(addAttribute(aInWorldPositions))
+
+    aOutMesh = tAttr.create("outMesh", "om", MFnMeshData::kMesh, &status);
+    CHECK_RETURN_STATUS(status)
+    tAttr.setStorable(false);
+    tAttr.setWritable(false);
+    CHECK_RETURN_STATUS(addAttribute(aOutMesh))
+
+    CHECK_RETURN_STATUS(attributeAffects(aInMesh, aOutMesh))
+    CHECK_RETURN_STATUS(attributeAffects(aInEdits, aOutMesh))
+    CHECK_RETURN_STATUS(attributeAffects(aInIndices, aOutMesh))
+    CHECK_RETURN_STATUS(attributeAffects(aInWorldPositions, aOutMesh))
+
+    return MS::kSuccess;
+}
+
+MStatus MVGMeshEditLogNode::setDependentsDirty(const MPlug& plug, MPlugArray& plugArray)
+{
+    // Edits are replayed from the new input mesh
+    if(plug == aInMesh)
+        _cachedMesh = MObject::kNullObj;
+    return MPxNode::setDependentsDirty(plug, plugArray);
+}
+
+MStatus MVGMeshEditLogNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if(plug != aOutMesh)
+        return MS::kUnknownParameter;
+
+    MStatus status;
+    MDataHandle inMeshHandle = data.inputValue(aInMesh, &status);
+    CHECK_RETURN_STATUS(status)
+    MDataHandle outMeshHandle = data.outputValue(aOutMesh, &status);
+    CHECK_RETURN_STATUS(status)
+
+    // state attribute
+    MDataHandle stateHandle = data.inputValue(state, &status);
+    CHECK_RETURN_STATUS(status)
+    if(stateHandle.asShort() == 1) // HasNoEffect/PassThrough
+    {
+        outMeshHandle.set(inMeshHandle.asMesh());
+        outMeshHandle.setClean();
+        return status;
+    }
+
+    // retrieve the log (arrays are not copied)
+    MFnIntArrayData editsFn(data.inputValue(aInEdits, &status).data());
+    const MIntArray edits = editsFn.array();
+    MFnIntArrayData indicesFn(data.inputValue(aInIndices, &status).data());
+    const MIntArray indices = indicesFn.array();
+    MFnPointArrayData worldPositionsFn(data.inputValue(aInWorldPositions, &status).data());
+    const MPointArray worldPositions = worldPositionsFn.array();
+    const int editCount = edits.length() / _EDIT_HEADER_SIZE;
+
+    // Replay the whole log if edits have been removed or replaced (undo)
+    MFnMeshData meshDataFn;
+    MFnMesh meshFn;
+    if(_cachedMesh.isNull() || _cachedEditCount > editCount ||
+       (_cachedEditCount > 0 &&
+        edits[(_cachedEditCount - 1) * _EDIT_HEADER_SIZE + 3] != _cachedLastSerial))
+    {
+        _cachedMesh = meshDataFn.create(&status);
+        CHECK_RETURN_STATUS(status)
+        meshFn.copy(inMeshHandle.asMesh(), _cachedMesh, &status);
+        CHECK_RETURN_STATUS(status)
+        _cachedEditCount = 0;
+        _cachedLastSerial = -1;
+        _cachedIndexOffset = 0;
+        _cachedPositionOffset = 0;
+    }
+
+    // Apply the new edits only
+    for(int i = _cachedEditCount; i < editCount; ++i)
+    {
+        const int type = edits[i * _EDIT_HEADER_SIZE];
+        const unsigned int indexCount = std::max(edits[i * _EDIT_HEADER_SIZE + 1], 0);
+        const unsigned int positionCount = std::max(edits[i * _EDIT_HEADER_SIZE + 2], 0);
+        if(_cachedIndexOffset + indexCount > indices.length() ||
+           _cachedPositionOffset + positionCount > worldPositions.length())
+        {
+            LOG_ERROR("Invalid edit log: " << name())
+            break;
+        }
+        MIntArray componentIDs;
+        for(unsigned int j = 0; j < indexCount; ++j)
+            componentIDs.append(indices[_cachedIndexOffset + j]);
+        MPointArray positions;
+        for(unsigned int j = 0; j < positionCount; ++j)
+            positions.append(worldPositions[_cachedPositionOffset + j]);
+        _editFactory.setMesh(_cachedMesh);
+        _editFactory.setComponentIDs(componentIDs);
+        _editFactory.setWorldPositions(positions);
+        _editFactory.setCameraPositions(MPointArray());
+        _editFactory.setClearBlindData(false);
+        _editFactory.setLegacyBlindData(false);
+        _editFactory.setEditType(static_cast<MVGMeshEditFactory::EditType>(type));
+        CHECK(_editFactory.doIt())
+        _cachedEditCount = i + 1;
+        _cachedLastSerial = edits[i * _EDIT_HEADER_SIZE + 3];
+        _cachedIndexOffset += indexCount;
+        _cachedPositionOffset += positionCount;
+    }
+
+    // The cached mesh keeps being edited, output a copy
+    MObject outMesh = meshDataFn.create(&status);
+    CHECK_RETURN_STATUS(status)
+    meshFn.copy(_cachedMesh, outMesh, &status);
+    CHECK_RETURN_STATUS(status)
+    outMeshHandle.set(outMesh);
+    outMeshHandle.setClean();
+    return status;
+}
+
+/**
+ * @param[in] meshPath : mesh shape
+ * @return the log node directly upstream of the mesh, or a null object
+ */
+MObject MVGMeshEditLogNode::getMeshLogNode(const MDagPath& meshPath)
+{
+    MStatus status;
+    MFnDependencyNode meshFn(meshPath.node(), &status);
+    CHECK_RETURN_VARIABLE(status, MObject::kNullObj)
+    MPlug inMeshPlug = meshFn.findPlug("inMesh", false, &status);
+    CHECK_RETURN_VARIABLE(status, MObject::kNullObj)
+    MPlugArray sources;
+    inMeshPlug.connectedTo(sources, true, false);
+    if(sources.length() == 0)
+        return MObject::kNullObj;
+    MObject node = sources[0].node();
+    MFnDependencyNode nodeFn(node);
+    if(nodeFn.typeId() != _id)
+        return MObject::kNullObj;
+    return node;
+}
+
+int MVGMeshEditLogNode::getEditCount(const MObject& node)
+{
+    MIntArray edits;
+    getIntArray(node, aInEdits, edits);
+    return edits.length() / _EDIT_HEADER_SIZE;
+}
+
+/**
+ * @param[in] node
+ * @param[in] type : kAddFace or kMove
+ * @param[in] componentIDs : moved vertices
+ * @param[in] worldPositions : new face points or moved vertices positions
+ * @param[in,out] serial : edit serial, assigned if negative (first call of a command)
+ */
+MStatus MVGMeshEditLogNode::appendEdit(const MObject& node,
+                                       const MVGMeshEditFactory::EditType type,
+                                       const MIntArray& componentIDs,
+                                       const MPointArray& worldPositions, int& serial)
+{
+    MIntArray edits;
+    getIntArray(node, aInEdits, edits);
+    if(serial < 0)
+    {
+        const int editCount = edits.length() / _EDIT_HEADER_SIZE;
+        if(editCount > 0)
+            _nextSerial = std::max(_nextSerial, edits[editCount * _EDIT_HEADER_SIZE - 1] + 1);
+        serial = _nextSerial++;
+    }
+    edits.append(type);
+    edits.append(componentIDs.length());
+    edits.append(worldPositions.length());
+    edits.append(serial);
+
+    MIntArray indices;
+    getIntArray(node, aInIndices, indices);
+    for(unsigned int i = 0; i < componentIDs.length(); ++i)
+        indices.append(componentIDs[i]);
+    MPointArray positions;
+    getPointArray(node, aInWorldPositions, positions);
+    for(unsigned int i = 0; i < worldPositions.length(); ++i)
+        positions.append(worldPositions[i]);
+
+    CHECK_RETURN_STATUS(setIntArray(node, aInIndices, indices))
+    CHECK_RETURN_STATUS(setPointArray(node, aInWorldPositions, positions))
+    // Last, as the header array defines which edits are valid
+    CHECK_RETURN_STATUS(setIntArray(node, aInEdits, edits))
+    return MS::kSuccess;
+}
+
+/**
+ * Keep the first editCount edits of the log (undo).
+ */
+MStatus MVGMeshEditLogNode::truncateEdits(const MObject& node, const int editCount)
+{
+    MIntArray edits;
+    getIntArray(node, aInEdits, edits);
+    if(editCount < 0 || editCount * _EDIT_HEADER_SIZE >= static_cast<int>(edits.length()))
+        return MS::kSuccess;
+    unsigned int indexCount = 0;
+    unsigned int positionCount = 0;
+    for(int i = 0; i < editCount; ++i)
+    {
+        indexCount += edits[i * _EDIT_HEADER_SIZE + 1];
+        positionCount += edits[i * _EDIT_HEADER_SIZE + 2];
+    }
+    edits.setLength(editCount * _EDIT_HEADER_SIZE);
+    MIntArray indices;
+    getIntArray(node, aInIndices, indices);
+    indices.setLength(std::min(indexCount, indices.length()));
+    MPointArray positions;
+    getPointArray(node, aInWorldPositions, positions);
+    positions.setLength(std::min(positionCount, positions.length()));
+
+    CHECK_RETURN_STATUS(setIntArray(node, aInEdits, edits))
+    CHECK_RETURN_STATUS(setIntArray(node, aInIndices, indices))
+    CHECK_RETURN_STATUS(setPointArray(node, aInWorldPositions, positions))
+    return MS::kSuccess;
+}
+
+} // namespace
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "mayaMVG/maya/mesh/MVGMeshEditFactory.hpp"
+#include <maya/MPxNode.h>
+#include <maya/MTypeId.h>
+
+class MDagPath;
+
+namespace mayaMVG
+{
+
+/**
+ * Single modifier node accumulating all the edits of a mesh, as a log stored in three flat
+ * arrays: per edit a header (type, index count, position count, serial), then the component
+ * indices and the world positions of all edits.
+ * The mesh with the edits applied is cached, so that appending an edit only replays this edit.
+ * The log is replayed from the input mesh when the input changes or when edits are removed.
+ */
+class MVGMeshEditLogNode : public MPxNode
+{
+public:
+    MVGMeshEditLogNode();
+    virtual ~MVGMeshEditLogNode();
+
+public:
+    virtual MStatus compute(const MPlug& plug, MDataBlock& data);
+    virtual MStatus setDependentsDirty(const MPlug& plug, MPlugArray& plugArray);
+    static void* creator();
+    static MStatus initialize();
+
+public:
+    static MObject getMeshLogNode(const MDagPath& meshPath);
+    static int getEditCount(const MObject& node);
+    static MStatus appendEdit(const MObject& node, const MVGMeshEditFactory::EditType type,
+                              const MIntArray& componentIDs, const MPointArray& worldPositions,
+                              int& serial);
+    static MStatus truncateEdits(const MObject& node, const int editCount);
+
+public:
+    static MTypeId _id;
+    static MObject aInMesh;
+    static MObject aInEdits;
+    static MObject aInIndices;
+    static MObject aInWorldPositions;
+    static MObject aOutMesh;
+    static const int _EDIT_HEADER_SIZE = 4;
+
+private:
+    static int _nextSerial; // serials are unique within a session, so replaced edits are detected
+    MObject _cachedMesh;    // input mesh with the first _cachedEditCount edits applied
+    int _cachedEditCount;
+    int _cachedLastSerial;
+    unsigned int _cachedIndexOffset;    // first index of the next edit
+    unsigned int _cachedPositionOffset; // first position of the next edit
+    MVGMeshEditFactory _editFactory;
+};
+
+} // namespace
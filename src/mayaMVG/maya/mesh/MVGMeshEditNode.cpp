@@ -27,6 +27,7 @@ MObject MVGMeshEditNode::aInWorldPositions;
 MObject MVGMeshEditNode::aInCameraPositions;
 MObject MVGMeshEditNode::aInCameraID;
 MObject MVGMeshEditNode::aInClearBlindData;
+MObject MVGMeshEditNode::aInLegacyBlindData;
 MObject MVGMeshEditNode::aInEditType;
 MObject MVGMeshEditNode::aOutMesh;
 
@@ -87,6 +88,13 @@ MStatus MVGMeshEditNode::initialize()
     nAttr.setStorable(true);
     CHECK_RETURN_STATUS(addAttribute(aInClearBlindData))
 
+    // True for nodes saved by previous versions, which stored blind data in the mesh data
+    aInLegacyBlindData =
+        nAttr.create("inLegacyBlindData", "ilb", MFnNumericData::kBoolean, true, &status);
+    CHECK_RETURN_STATUS(status)
+    nAttr.setStorable(true);
+    CHECK_RETURN_STATUS(addAttribute(aInLegacyBlindData))
+
     aInEditType = eAttr.create("inEditType", "iet", 0, &status);
     CHECK_RETURN_STATUS(status)
     eAttr.setStorable(true);
@@ -106,6 +114,7 @@ MStatus MVGMeshEditNode::initialize()
     CHECK_RETURN_STATUS(attributeAffects(aInWorldPositions, aOutMesh))
     CHECK_RETURN_STATUS(attributeAffects(aInCameraPositions, aOutMesh))
     CHECK_RETURN_STATUS(attributeAffects(aInCameraID, aOutMesh))
+    CHECK_RETURN_STATUS(attributeAffects(aInLegacyBlindData, aOutMesh))
     CHECK_RETURN_STATUS(attributeAffects(aInEditType, aOutMesh))
 
     return MS::kSuccess;
@@ -157,6 +166,7 @@ MStatus MVGMeshEditNode::compute(const MPlug& plug, MDataBlock& data)
 
     // retrieve clearBD
     MDataHandle clearBlindDataHandle = data.outputValue(aInClearBlindData, &status);
+    MDataHandle legacyBlindDataHandle = data.outputValue(aInLegacyBlindData, &status);
 
     // retrieve edit type
     MDataHandle editTypeHandle = data.outputValue(aInEditType, &status);
@@ -170,6 +180,7 @@ MStatus MVGMeshEditNode::compute(const MPlug& plug, MDataBlock& data)
     _editFactory.setCameraPositions(cameraPositionArray);
     _editFactory.setCameraID(cameraIDHandle.asInt());
     _editFactory.setClearBlindData(clearBlindDataHandle.asBool());
+    _editFactory.setLegacyBlindData(legacyBlindDataHandle.asBool());
     _editFactory.setEditType(static_cast<MVGMeshEditFactory::EditType>(editTypeHandle.asShort()));
     // perform mesh operation
     CHECK_RETURN_STATUS(_editFactory.doIt())
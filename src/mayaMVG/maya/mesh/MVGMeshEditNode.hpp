@@ -27,6 +27,7 @@ public:
     static MObject aInCameraPositions;
     static MObject aInCameraID;
     static MObject aInClearBlindData;
+    static MObject aInLegacyBlindData;
     static MObject aInEditType;
     static MObject aOutMesh;
 
@@ -1,4 +1,6 @@
 #include "mayaMVG/core/MVGLog.hpp"
+#include "mayaMVG/core/MVGCameraRegistry.hpp"
+#include "mayaMVG/core/MVGPointCloud.hpp"
 #include "mayaMVG/version.hpp"
 #include "mayaMVG/maya/MVGMayaUtil.hpp"
 #include "mayaMVG/maya/MVGMayaCallbacks.hpp"
@@ -6,13 +8,16 @@
 #include "mayaMVG/maya/cmd/MVGEditCmd.hpp"
 #include "mayaMVG/maya/cmd/MVGImagePlaneCmd.hpp"
 #include "mayaMVG/maya/cmd/MVGSelectClosestCamCmd.hpp"
+#include "mayaMVG/maya/cmd/MVGMeshHistoryCmd.hpp"
 #include "mayaMVG/maya/context/MVGContextCmd.hpp"
+#include "mayaMVG/maya/context/MVGMeshWatcher.hpp"
 #include "mayaMVG/maya/context/MVGCreateManipulator.hpp"
 #include "mayaMVG/maya/context/MVGMoveManipulator.hpp"
 #include "mayaMVG/maya/context/MVGLocatorManipulator.hpp"
 #include "mayaMVG/maya/context/MVGCreateManipulatorDrawOverride.hpp"
 #include "mayaMVG/maya/context/MVGMoveManipulatorDrawOverride.hpp"
 #include "mayaMVG/maya/mesh/MVGMeshEditNode.hpp"
+#include "mayaMVG/maya/mesh/MVGMeshEditLogNode.hpp"
 #include "mayaMVG/maya/MVGDummyLocator.h"
 #include "mayaMVG/maya/MVGCameraPointsLocator.hpp"
 #include <maya/MFnPlugin.h>
@@ -139,7 +144,10 @@ MStatus initializePlugin(MObject obj)
     CHECK(plugin.registerCommand("MVGCmd", MVGCmd::creator))
     CHECK(plugin.registerCommand("MVGImagePlaneCmd", MVGImagePlaneCmd::creator,
                                  MVGImagePlaneCmd::newSyntax))
-    CHECK(plugin.registerCommand(MVGSelectClosestCamCmd::_name, MVGSelectClosestCamCmd::creator))
+    CHECK(plugin.registerCommand(MVGSelectClosestCamCmd::_name, MVGSelectClosestCamCmd::creator,
+                                 MVGSelectClosestCamCmd::newSyntax))
+    CHECK(plugin.registerCommand(MVGMeshHistoryCmd::_name, MVGMeshHistoryCmd::creator,
+                                 MVGMeshHistoryCmd::newSyntax))
     CHECK(plugin.registerContextCommand(MVGContextCmd::name, &MVGContextCmd::creator,
                                         MVGEditCmd::_name, MVGEditCmd::creator,
                                         MVGEditCmd::newSyntax))
@@ -161,6 +169,8 @@ MStatus initializePlugin(MObject obj)
                               &MVGCameraPointsLocator::initialize, MPxNode::kLocatorNode, &MVGCameraPointsLocator::classification))
     CHECK(plugin.registerNode("MVGMeshEditNode", MVGMeshEditNode::_id, MVGMeshEditNode::creator,
                               MVGMeshEditNode::initialize))
+    CHECK(plugin.registerNode("MVGMeshEditLogNode", MVGMeshEditLogNode::_id,
+                              MVGMeshEditLogNode::creator, MVGMeshEditLogNode::initialize))
 
     // Register draw overrides
     CHECK(MHWRender::MDrawRegistry::registerDrawOverrideCreator(
@@ -191,12 +201,6 @@ MStatus initializePlugin(MObject obj)
     if(status)
         _callbacks.append(id);
     id = MEventMessage::addEventCallback("SceneOpened", sceneChangedCB, &status);
-    if(status)
-        _callbacks.append(id);
-    id = MEventMessage::addEventCallback("Undo", undoCB, &status);
-    if(status)
-        _callbacks.append(id);
-    id = MEventMessage::addEventCallback("Redo", redoCB, &status);
     if(status)
         _callbacks.append(id);
     id = MEventMessage::addEventCallback("quitApplication", quitApplicationCB, &status);
@@ -218,6 +222,12 @@ MStatus initializePlugin(MObject obj)
     if(status)
         _callbacks.append(id);
     id = MDGMessage::addNodeAddedCallback(nodeAddedCB, "objectSet", &status);
+    if(status)
+        _callbacks.append(id);
+    id = MDGMessage::addNodeAddedCallback(nodeAddedCB, "camera", &status);
+    if(status)
+        _callbacks.append(id);
+    id = MDGMessage::addNodeRemovedCallback(nodeRemovedCB, "camera", &status);
     if(status)
         _callbacks.append(id);
 
@@ -246,16 +256,21 @@ MStatus uninitializePlugin(MObject obj)
     // Deregister Maya callbacks
     CHECK(MUserEventMessage::deregisterUserEvent(_modeChangedEvent))
     CHECK(MMessage::removeCallbacks(_callbacks))
+    MVGCameraRegistry::invalidate();
+    MVGPointCloud::clearPositionsCache();
+    MVGMeshWatcher::clear();
 
     // Deregister Maya context, commands & nodes
     CHECK(plugin.deregisterCommand("MVGCmd"))
     CHECK(plugin.deregisterCommand("MVGSelectClosestCamCmd"))
     CHECK(plugin.deregisterCommand("MVGImagePlaneCmd"))
+    CHECK(plugin.deregisterCommand(MVGMeshHistoryCmd::_name))
     CHECK(plugin.deregisterContextCommand(MVGContextCmd::name, MVGEditCmd::_name))
     CHECK(plugin.deregisterNode(MVGCreateManipulator::_id))
     CHECK(plugin.deregisterNode(MVGMoveManipulator::_id))
     CHECK(plugin.deregisterNode(MVGLocatorManipulator::_id))
     CHECK(plugin.deregisterNode(MVGMeshEditNode::_id))
+    CHECK(plugin.deregisterNode(MVGMeshEditLogNode::_id))
     CHECK(plugin.deregisterNode(MVGDummyLocator::_id))
     CHECK(plugin.deregisterNode(MVGCameraPointsLocator::_id))
 
@@ -1,6 +1,4 @@
 #include "mayaMVG/qt/MVGCameraWrapper.hpp"
-#include <QImage>
-#include <QFileInfo>
 
 namespace mayaMVG
 {
@@ -8,16 +6,16 @@ namespace mayaMVG
 MVGCameraWrapper::MVGCameraWrapper(const MVGCamera& camera, QObject* parent)
     : QObject(parent)
     , _camera(camera)
+    , _imageWeight(-1)
     , _isSelected(false)
-    , _imageLoaded(false)
 {
 }
 
 MVGCameraWrapper::MVGCameraWrapper(const MVGCameraWrapper& other)
     : QObject(other.parent())
     , _camera(other._camera)
-    , _imageLoaded(other._imageLoaded)
     , _imageSize(other._imageSize)
+    , _imageWeight(other._imageWeight)
     , _isSelected(other._isSelected)
     , _views(other._views)
 {
@@ -63,22 +61,13 @@ void MVGCameraWrapper::setIsSelected(const bool isSelected)
     Q_EMIT isSelectedChanged();
 }
 
-const QSize MVGCameraWrapper::getSourceSize()
+void MVGCameraWrapper::setSourceInfo(const QSize& size, const qint64 weight)
 {
-    // TODO : do not load image
-    if(!_imageLoaded)
-    {
-        QImage image(getImagePath());
-        _imageLoaded = true;
-        _imageSize = image.size();
-    }
-    return _imageSize;
-}
-
-const qint64 MVGCameraWrapper::getSourceWeight() const
-{
-    QFileInfo info(getImagePath());
-    return info.size();
+    if(_imageSize == size && _imageWeight == weight)
+        return;
+    _imageSize = size;
+    _imageWeight = weight;
+    Q_EMIT sourceInfoChanged();
 }
 
 void MVGCameraWrapper::selectCameraNode() const
@@ -17,8 +17,8 @@ class MVGCameraWrapper : public QObject
     Q_PROPERTY(QString imagePath READ getImagePath CONSTANT)
     Q_PROPERTY(bool isSelected READ isSelected WRITE setIsSelected NOTIFY isSelectedChanged)
     Q_PROPERTY(QStringList views READ getViews NOTIFY viewsChanged)
-    Q_PROPERTY(QSize sourceSize READ getSourceSize CONSTANT)
-    Q_PROPERTY(qint64 sourceWeight READ getSourceWeight CONSTANT)
+    Q_PROPERTY(QSize sourceSize READ getSourceSize NOTIFY sourceInfoChanged)
+    Q_PROPERTY(qint64 sourceWeight READ getSourceWeight NOTIFY sourceInfoChanged)
 
 public:
     MVGCameraWrapper(const MVGCamera& camera, QObject* parent=nullptr);
@@ -35,12 +35,14 @@ public Q_SLOTS:
     bool isSelected() const { return _isSelected; }
     void setIsSelected(const bool isSelected);
     const QStringList& getViews() const { return _views; }
-    const QSize getSourceSize();
-    const qint64 getSourceWeight() const;
+    const QSize getSourceSize() const { return _imageSize; }
+    const qint64 getSourceWeight() const { return _imageWeight; }
+    void setSourceInfo(const QSize& size, const qint64 weight);
 
 Q_SIGNALS:
     void isSelectedChanged();
     void viewsChanged();
+    void sourceInfoChanged();
 
 public:
     const MVGCamera& getCamera() const;
@@ -50,8 +52,9 @@ public:
 
 private:
     const MVGCamera _camera;
-    bool _imageLoaded;
+    /// Filled by the background scan of the project wrapper (invalid/-1 until then)
     QSize _imageSize;
+    qint64 _imageWeight;
     bool _isSelected;
     QStringList _views; //< camera is displayed in thoses views
 };
@@ -0,0 +1,84 @@
+#include "mayaMVG/qt/MVGImageInfoScanner.hpp"
+#include "mayaMVG/qt/MVGThumbnailCache.hpp"
+#include <QFileInfo>
+#include <QRunnable>
+#include <QSize>
+#include <QThreadPool>
+
+namespace mayaMVG
+{
+
+namespace
+{ // empty namespace
+
+QThreadPool& getThreadPool()
+{
+    static QThreadPool threadPool;
+    static bool initialized = false;
+    if(!initialized)
+    {
+        threadPool.setMaxThreadCount(MVGImageInfoScanner::_MAX_CONCURRENT_READS);
+        initialized = true;
+    }
+    return threadPool;
+}
+
+class ImageInfoTask : public QRunnable
+{
+public:
+    ImageInfoTask(const QString& dagPath, const QString& imagePath, QObject* receiver,
+                  const char* receiverSlot)
+        : _dagPath(dagPath)
+        , _imagePath(imagePath)
+        , _receiver(receiver)
+        , _receiverSlot(receiverSlot)
+    {
+    }
+    void run() override
+    {
+        const QFileInfo info(_imagePath);
+        const qint64 weight = info.exists() ? info.size() : 0;
+        const QSize size = MVGThumbnailCache::readImageSize(_imagePath);
+        QMetaObject::invokeMethod(_receiver, _receiverSlot, Qt::QueuedConnection,
+                                  Q_ARG(QString, _dagPath), Q_ARG(QSize, size),
+                                  Q_ARG(qint64, weight));
+    }
+
+private:
+    const QString _dagPath;
+    const QString _imagePath;
+    QObject* _receiver;
+    const char* _receiverSlot;
+};
+
+} // empty namespace
+
+const int MVGImageInfoScanner::_MAX_CONCURRENT_READS = 4;
+
+/**
+ * Cancel the previous scan and start a new one.
+ * @param[in] dagPaths : camera dag paths, sent back with the results
+ * @param[in] imagePaths : image of each camera
+ * @param[in] receiver : must live until the end of the scan (see cancel)
+ * @param[in] receiverSlot : name of the receiver slot or Q_INVOKABLE method
+ */
+void MVGImageInfoScanner::scan(const QStringList& dagPaths, const QStringList& imagePaths,
+                               QObject* receiver, const char* receiverSlot)
+{
+    QThreadPool& threadPool = getThreadPool();
+    threadPool.clear();
+    for(int i = 0; i < dagPaths.size() && i < imagePaths.size(); ++i)
+        threadPool.start(new ImageInfoTask(dagPaths[i], imagePaths[i], receiver, receiverSlot));
+}
+
+/**
+ * Remove the pending reads and wait for the running ones
+ */
+void MVGImageInfoScanner::cancel()
+{
+    QThreadPool& threadPool = getThreadPool();
+    threadPool.clear();
+    threadPool.waitForDone();
+}
+
+} // namespace
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QObject>
+#include <QStringList>
+
+namespace mayaMVG
+{
+
+/**
+ * Read the file size and the image dimensions (header only) of the camera images on worker
+ * threads, with a bounded number of concurrent reads.
+ * Each result is delivered to the receiver in its own thread with a queued call of
+ * receiverSlot(const QString& dagPath, const QSize& size, qint64 weight).
+ */
+class MVGImageInfoScanner
+{
+public:
+    static void scan(const QStringList& dagPaths, const QStringList& imagePaths,
+                     QObject* receiver, const char* receiverSlot);
+    static void cancel();
+
+public:
+    /// Maximum number of files read at the same time
+    static const int _MAX_CONCURRENT_READS;
+};
+
+} // namespace
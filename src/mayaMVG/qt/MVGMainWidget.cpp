@@ -4,6 +4,9 @@
 #include "mayaMVG/maya/MVGMayaUtil.hpp"
 #include "mayaMVG/qt/MVGCameraWrapper.hpp"
 #include "mayaMVG/qt/MVGCameraSetWrapper.hpp"
+#include "mayaMVG/qt/MVGImageInfoScanner.hpp"
+#include "mayaMVG/qt/MVGThumbnailCache.hpp"
+#include "mayaMVG/qt/MVGThumbnailProvider.hpp"
 #include <QFocusEvent>
 #include <QQuickWidget>
 #include <QQmlEngine>
@@ -30,6 +33,9 @@ MVGMainWidget::MVGMainWidget(QWidget* parent)
     _view->engine()->addPluginPath(importDirectory);
     _view->engine()->addImportPath(importDirectory);
 
+    // Camera thumbnails, the engine takes ownership of the provider
+    _view->engine()->addImageProvider(MVGThumbnailProvider::_NAME, new MVGThumbnailProvider);
+
     // Expose Project to QML
     _view->rootContext()->setContextProperty("_project", &_projectWrapper);
 
@@ -52,6 +58,8 @@ MVGMainWidget::MVGMainWidget(QWidget* parent)
 MVGMainWidget::~MVGMainWidget()
 {
     _projectWrapper.clearAndUnloadImageCache();
+    MVGImageInfoScanner::cancel();
+    MVGThumbnailCache::cancelThumbnailsGeneration();
 }
 
 void MVGMainWidget::focusOutEvent(QFocusEvent* event)
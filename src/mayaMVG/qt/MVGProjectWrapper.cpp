@@ -1,12 +1,16 @@
 #include "mayaMVG/qt/MVGProjectWrapper.hpp"
 #include "mayaMVG/version.hpp"
 #include <QCoreApplication>
+#include <QFileInfo>
 #include "MVGCameraSetWrapper.hpp"
 #include "mayaMVG/qt/MVGCameraWrapper.hpp"
 #include "mayaMVG/qt/MVGMeshWrapper.hpp"
+#include "mayaMVG/qt/MVGThumbnailCache.hpp"
+#include "mayaMVG/qt/MVGImageInfoScanner.hpp"
 #include "mayaMVG/maya/MVGMayaUtil.hpp"
 #include "mayaMVG/core/MVGLog.hpp"
 #include "mayaMVG/core/MVGPointCloud.hpp"
+#include "mayaMVG/core/MVGGeometryUtil.hpp"
 #include "mayaMVG/maya/context/MVGContextCmd.hpp"
 #include "mayaMVG/maya/context/MVGContext.hpp"
 #include "mayaMVG/maya/context/MVGMoveManipulator.hpp"
@@ -26,57 +30,15 @@
 #include <maya/MItSelectionList.h>
 #include <maya/MObjectSetMessage.h>
 #include <maya/MDagModifier.h>
+#include <maya/MProgressWindow.h>
+#include <maya/MDoubleArray.h>
+#include <maya/MFnSingleIndexedComponent.h>
+#include <functional>
+#include <algorithm>
 
 namespace mayaMVG
 {
 
-namespace  // Utility functions
-{
-
-/**
- * Give the number of occurrences of each element in the given sets.
- *
- * @param sets the sets to consider
- * @return a map element => count
- */
-template <typename T>
-std::map<T, int> countElements(const std::vector< std::set<T> >& sets)
-{
-    std::map<T, int> idWeights;
-    for(const auto& set : sets)
-    {
-        for(const auto& elt : set)
-        {
-            if(idWeights.find(elt) != idWeights.end())
-                idWeights[elt]++;
-            else
-                idWeights[elt] = 1;
-        }
-    }
-    return idWeights;
-}
-
-/**
- * Returns the intersection (common elements) of the given sets.
- *
- * @param sets the sets to consider
- * @return the intersection of all the sets
- */
-template <typename T>
-std::set<T> setsIntersection(const std::vector< std::set<T> >& sets)
-{
-    std::set<T> intersection;
-    const auto weights = countElements(sets);
-    for(const auto& elt : weights)
-    {
-        if(elt.second > 1)
-            intersection.insert(elt.first);
-    }
-    return intersection;
-}
-
-}
-
 MVGProjectWrapper::MVGProjectWrapper(QObject* parent):
 QObject(parent),
 _currentCameraSetId(0),
@@ -113,6 +75,7 @@ _cameraPointsLocatorCB(0)
     // Init _isProjectLoading
     _isProjectLoading = false;
     _activeSynchro = true;
+    _isMayaSelectionUpdateQueued = false;
 
     // Force re-evaluation of current camera set index whenever the cameraSet model is modified
     connect(&_cameraSets, SIGNAL(countChanged()), this, SIGNAL(currentCameraSetIndexChanged()));
@@ -270,30 +233,117 @@ void MVGProjectWrapper::setUseParticleSelection(bool value)
     Q_EMIT useParticleSelectionChanged();
 }
 
-void MVGProjectWrapper::updateParticleSelection(const std::set<int>& selection)
+void MVGProjectWrapper::updateParticleSelection(const std::vector<int>& selection)
 {
     if(!useParticleSelection())
         return;
 
-    if(selection == _particleSelection)
+    std::vector<int> sortedSelection(selection);
+    // Components read from Maya are usually sorted already
+    if(std::adjacent_find(sortedSelection.begin(), sortedSelection.end(),
+                          std::greater_equal<int>()) != sortedSelection.end())
+    {
+        std::sort(sortedSelection.begin(), sortedSelection.end());
+        sortedSelection.erase(std::unique(sortedSelection.begin(), sortedSelection.end()),
+                              sortedSelection.end());
+    }
+    if(sortedSelection == _particleSelection)
+        return;
+
+    _particleSelection.swap(sortedSelection);
+    _visibilityIndex.countPointsPerCamera(_particleSelection, _selectionScorePerSlot);
+    Q_EMIT particleSelectionCountChanged();
+    updateCamerasFromParticleSelection(true);
+}
+
+/**
+ * Process the Maya selection once control returns to the event loop, whatever the number of
+ * selection changes until then.
+ */
+void MVGProjectWrapper::queueMayaSelectionUpdate()
+{
+    if(_isMayaSelectionUpdateQueued)
         return;
+    _isMayaSelectionUpdateQueued = true;
+    QMetaObject::invokeMethod(this, "updateFromMayaSelection", Qt::QueuedConnection);
+}
 
-    _particleSelection = selection;
-    _selectionScorePerCamera.clear();
+/**
+ * Synchronize UI selection (cameras, meshes and particles) with the current Maya selection.
+ */
+void MVGProjectWrapper::updateFromMayaSelection()
+{
+    _isMayaSelectionUpdateQueued = false;
+    if(!_activeSynchro)
+        return;
+    MSelectionList list;
+    MGlobal::getActiveSelectionList(list);
+    MItSelectionList selectionIt(list);
+    MDagPath path;
+    MObject component;
+    QStringList selectedCameras;
+    QStringList selectedMeshes;
+    _mayaSelectedParticles.clear();
+    bool particleSelectionChanged = false;
 
-    for(const auto& pointId : _particleSelection)
+    for(; !selectionIt.isDone(); selectionIt.next())
     {
-        if(!_camerasPerPoint.count(pointId))
+        selectionIt.getDagPath(path, component);
+        path.extendToShape();
+        if(!path.isValid())
             continue;
-        for(auto* camWrapper : _camerasPerPoint[pointId])
+
+        switch(path.apiType())
         {
-            if(!_selectionScorePerCamera.count(camWrapper))
-                _selectionScorePerCamera[camWrapper] = 0;
-            _selectionScorePerCamera[camWrapper]++;
+            case MFn::kCamera:
+                selectedCameras.push_back(path.fullPathName().asChar());
+                break;
+            case MFn::kMesh:
+                selectedMeshes.push_back(path.fullPathName().asChar());
+                break;
+            case MFn::kParticle:
+            {
+                if(component.isNull())
+                    break;
+                particleSelectionChanged = true;
+                // Copy the component indices in one block
+                const MFnSingleIndexedComponent cpts(component);
+                MIntArray indices;
+                cpts.getElements(indices);
+                const size_t offset = _mayaSelectedParticles.size();
+                _mayaSelectedParticles.resize(offset + indices.length());
+                if(indices.length() > 0)
+                    indices.get(&_mayaSelectedParticles[offset]);
+                break;
+            }
+            default:
+                break;
         }
     }
-    Q_EMIT particleSelectionCountChanged();
-    updateCamerasFromParticleSelection(true);
+
+    // Compare IHM selection to Maya selection
+    if(!selectedCameras.empty())
+    {
+        QStringList IHMSelectedCamera = _selectedCameras;
+        IHMSelectedCamera.sort();
+        selectedCameras.sort();
+        if(IHMSelectedCamera != selectedCameras)
+            addCamerasToIHMSelection(selectedCameras, true);
+    }
+    else
+        clearCameraSelection();
+    if(!selectedMeshes.empty())
+    {
+        QStringList IHMSelectedMeshes = _selectedMeshes;
+        IHMSelectedMeshes.sort();
+        selectedMeshes.sort();
+        if(IHMSelectedMeshes != selectedMeshes)
+            addMeshesToIHMSelection(selectedMeshes, true);
+    }
+    else
+        clearMeshSelection();
+    if(list.length() == 0 || particleSelectionChanged)
+        updateParticleSelection(_mayaSelectedParticles);
 }
 
 void MVGProjectWrapper::setFilterPoints(bool value) {
@@ -327,28 +377,20 @@ void MVGProjectWrapper::updateParticlesOpacity()
 
     if(_filterPoints)
     {
-        // Set opacity to 0 for all particles
-        pc.setOpacity(0);
-        // set opacity to 1 for particles visible by cams in current set
-        std::set<int> indices;
-        std::map<int, int> indexScore;
-        MIntArray array;
+        // Update coverage with the cameras entering or leaving the current set
+        std::vector<int> slots;
         for(auto* wrapper : _currentCameraSet->getCameras()->asQList<MVGCameraWrapper>())
+            slots.push_back(_visibilityIndex.getSlot(wrapper->getCamera().getId()));
+        _pointCoverage.setActiveCameras(_visibilityIndex, slots);
+        // Set opacity to 1 for particles visible by enough cams in current set, 0 otherwise
+        const std::vector<int>& coverage = _pointCoverage.getCoveragePerPoint();
+        MDoubleArray opacities(coverage.size(), 0.0);
+        for(size_t i = 0; i < coverage.size(); ++i)
         {
-
-            wrapper->getCamera().getVisibleIndexes(array);
-            for(unsigned int i=0; i < array.length(); ++i)
-            {
-                indexScore[array[i]]++;
-            }
-        }
-        array.clear();
-        for(const auto& indexToScore : indexScore)
-        {
-            if(indexToScore.second > _pointsFilteringThreshold)
-                array.append(indexToScore.first);
+            if(coverage[i] > _pointsFilteringThreshold)
+                opacities[i] = 1.0;
         }
-        pc.setOpacity(array, 1.0);
+        pc.setOpacity(opacities);
     }
     else
     {
@@ -440,7 +482,9 @@ void MVGProjectWrapper::loadABC(const QString& abcFilePath)
     if(abcFilePath.isEmpty())
         return;
 
-    // Load abc
+    // Load abc, with Maya's reader : the plugin doesn't link against the Alembic SDK.
+    // Cameras and point cloud attributes are the ones created by AbcImport from the Alembic
+    // user properties (see MVGCamera and MVGPointCloud).
     MString cmd;
     cmd.format("AbcImport -mode import \"^1s\"", abcFilePath.toStdString().c_str());
     status = MGlobal::executeCommand(cmd);
@@ -484,31 +528,11 @@ void MVGProjectWrapper::loadABC(const QString& abcFilePath)
     MDagPath pointCloudDagPath;
     MDagPath::getAPathTo(cloudGroupPath.child(0), pointCloudDagPath);
     pointCloudDagPath.extendToShape();
-    MObject pointCloud = pointCloudDagPath.node();
 
     // Visibility
-    MIntArray visibilitySizeArray;
-    status =
-        MVGMayaUtil::getIntArrayAttribute(pointCloud, "mvg_visibilitySize", visibilitySizeArray);
-    CHECK_RETURN(status)
-    MIntArray visibilityIDsArray;
-    status = MVGMayaUtil::getIntArrayAttribute(pointCloud, "mvg_visibilityIds", visibilityIDsArray);
+    status = MVGPointCloud(pointCloudDagPath).getVisibility(_visibilityIndex);
     CHECK_RETURN(status)
-
-    int k = 0;
-    std::map<int, MIntArray> itemsPerCam;
-    // Browse 3D points
-    for(int j = 0; j < visibilitySizeArray.length(); ++j)
-    {
-        int nbView = visibilitySizeArray[j];
-        int lastPosition = k + (nbView - 1) * 2;
-        // Browse visibility
-        for(; k < lastPosition + 1; k += 2)
-        {
-            int viewID = visibilityIDsArray[k];
-            itemsPerCam[viewID].append(j);
-        }
-    }
+    _pointCoverage.clear();
 
     // Cameras
     if(cameraGroupPath.childCount() == 0)
@@ -519,22 +543,39 @@ void MVGProjectWrapper::loadABC(const QString& abcFilePath)
 
     MDagPathArray cameras;
     cameraGroupPath.getAllPathsBelow(cameras);
-
+    MDagPathArray cameraShapes;
     for(unsigned int i = 0; i < cameras.length(); ++i)
     {
-        MDagPath cameraDagPath = cameras[i];
-        if(cameraDagPath.apiType() != MFn::kCamera)
-            continue;
-        MVGCamera::create(cameraDagPath, itemsPerCam);
+        if(cameras[i].apiType() == MFn::kCamera)
+            cameraShapes.append(cameras[i]);
     }
 
-    // Set images paths
-    cmd.format("from mayaMVG import camera;\n"
-               "camera.setImagesPaths('^1s', '^2s', '^3s', '^4s', '^5s')",
-               abcFilePath.toStdString().c_str(), MVGCamera::_MVG_IMAGE_PATH.asChar(),
-               MVGCamera::_MVG_IMAGE_SOURCE_PATH.asChar(), MVGCamera::_MVG_THUMBNAIL_PATH.asChar(),
-               MVGCamera::_MVG_VIEW_ID.asChar());
-    MGlobal::executePythonCommand(cmd);
+    // Configure cameras by batches, to report progress
+    const unsigned int batchSize = 100;
+    const std::string projectDirectory = QFileInfo(abcFilePath).path().toStdString();
+    const bool showProgress = MProgressWindow::reserve();
+    if(showProgress)
+    {
+        MProgressWindow::setTitle("MayaMVG");
+        MProgressWindow::setProgressStatus("Loading cameras...");
+        MProgressWindow::setProgressRange(0, cameraShapes.length());
+        MProgressWindow::startProgress();
+    }
+    for(unsigned int i = 0; i < cameraShapes.length(); i += batchSize)
+    {
+        MDagPathArray batch;
+        for(unsigned int j = i; j < std::min(i + batchSize, cameraShapes.length()); ++j)
+            batch.append(cameraShapes[j]);
+        std::vector<MVGCamera> batchCameras = MVGCamera::create(batch, _visibilityIndex);
+        // Set images paths
+        for(std::vector<MVGCamera>::const_iterator it = batchCameras.begin();
+            it != batchCameras.end(); ++it)
+            it->setImagesPaths(projectDirectory);
+        if(showProgress)
+            MProgressWindow::advanceProgress(batch.length());
+    }
+    if(showProgress)
+        MProgressWindow::endProgress();
 
     _project.lockProject();
 
@@ -672,6 +713,8 @@ void MVGProjectWrapper::setCameraToView(MVGCameraWrapper* cameraWrapper, const Q
 {
     // Push command
     _project.pushLoadCurrentImagePlaneCommand(viewName.toStdString());
+    if(cameraWrapper)
+        prefetchNeighbourImages(*cameraWrapper);
     // Set UI
     for(const auto& cam : _camerasByName)
     {
@@ -736,32 +779,27 @@ void MVGProjectWrapper::initCameraPointsLocator()
 
 void MVGProjectWrapper::updatePointsVisibility()
 {
-    std::vector< std::set<int> > pointsSets;
-    pointsSets.reserve(_activeCameraNameByView.size());
-    std::map< std::string, std::set<int>* > pointsPerCamera;
+    // Count the panels seeing each point (saturated to 2), from the sorted visible points of
+    // each panel camera
+    std::vector<std::pair<const int*, int>> pointsPerView;
+    pointsPerView.reserve(_activeCameraNameByView.size());
+    std::vector<unsigned char> viewCountPerPoint(_visibilityIndex.getPointCount(), 0);
     for(const auto& camByView : _activeCameraNameByView)
     {
         MVGCameraWrapper* camWrapper = cameraFromViewName(QString::fromStdString(camByView.first));
         if(!camWrapper)
             return;
-        std::set<int> visibility;
-        MIntArray visibleIndexes;
-        camWrapper->getCamera().getVisibleIndexes(visibleIndexes);
-        for(unsigned int i = 0; i < visibleIndexes.length(); ++i)
-            visibility.insert(visibleIndexes[i]);
-        pointsSets.push_back(visibility);
-        // pointsSets won't be resized (because reserved);
-        // we can use pointers to avoid data duplication
-        pointsPerCamera[camByView.second] = &pointsSets.back();
+        const int slot = _visibilityIndex.getSlot(camWrapper->getCamera().getId());
+        const int* points = nullptr;
+        const int count = _visibilityIndex.getPoints(slot, points);
+        for(int i = 0; i < count; ++i)
+        {
+            if(viewCountPerPoint[points[i]] < 2)
+                ++viewCountPerPoint[points[i]];
+        }
+        pointsPerView.push_back(std::make_pair(points, count));
     }
 
-    // Remove common points from individual camera points lists
-    // to avoid z-fighting when drawing them
-    const std::set<int> intersection = setsIntersection(pointsSets);
-    for(const auto& cameraPoints : pointsPerCamera)
-        for(const auto& point : intersection)
-            cameraPoints.second->erase(point);
-
     MObject locator;
     MStatus status;
     status = MVGMayaUtil::getObjectByName(MVGProject::_CAMERA_POINTS_LOCATOR.c_str(), locator);
@@ -770,33 +808,51 @@ void MVGProjectWrapper::updatePointsVisibility()
     status = MDagPath::getAPathTo(locator, locatorPath);
     CHECK_RETURN(status)
 
-    std::vector<MVGPointCloudItem> allPoints;
-    MVGPointCloud pointCloud(MVGProject::_CLOUD);
-    pointCloud.getItems(allPoints);
+    const aliceVision::Mat3X& positions = MVGPointCloud(MVGProject::_CLOUD).getPositions();
 
-    // PointCloudItem positions are in world space;
+    // Cloud positions are in world space;
     // multiply them by the locator inverse matrix to be independent from the locator transform
     const MMatrix locatorInverseMatrix = locatorPath.inclusiveMatrixInverse().transpose();
 
     // Fill locator points attributes (based on panel name)
+    // Common points are removed from individual camera points lists
+    // to avoid z-fighting when drawing them
     // TODO: make it more generic
+    std::vector<int> commonPoints;
+    size_t viewIndex = 0;
     for(const auto& camByView : _activeCameraNameByView)
     {
         const std::string& camName = camByView.second;
         if(camName.empty())
             return;
         const std::string& attrName = camByView.first + "Points";
-        const auto& cameraPoints = *(pointsPerCamera[camName]);
+        const int* points = pointsPerView[viewIndex].first;
+        const int count = pointsPerView[viewIndex].second;
+        ++viewIndex;
         MPointArray array;
-        for(const auto& point : cameraPoints)
-            array.append(locatorInverseMatrix * allPoints[point]._position);
+        if(count > 0)
+            array.setSizeIncrement(count);
+        for(int i = 0; i < count; ++i)
+        {
+            const int point = points[i];
+            if(point >= positions.cols())
+                continue;
+            if(viewCountPerPoint[point] == 1)
+                array.append(locatorInverseMatrix * TO_MPOINT(positions.col(point)));
+            else if(viewCountPerPoint[point] == 2)
+            {
+                commonPoints.push_back(point);
+                viewCountPerPoint[point] = 0; // only once
+            }
+        }
         MVGMayaUtil::setPointArrayAttribute(locator, attrName.c_str(), array);
     }
 
     { // Common points
         MPointArray array;
-        for(const auto& point : intersection)
-            array.append(locatorInverseMatrix * allPoints[point]._position);
+        array.setLength(commonPoints.size());
+        for(size_t i = 0; i < commonPoints.size(); ++i)
+            array.set(locatorInverseMatrix * TO_MPOINT(positions.col(commonPoints[i])), i);
         MVGMayaUtil::setPointArrayAttribute(locator, "mvgCommonPoints", array);
     }
 }
@@ -834,12 +890,13 @@ void MVGProjectWrapper::setCameraLocatorScale(const double scale)
 void MVGProjectWrapper::selectCamerasPoints()
 {
     std::set<int> points;
-    MIntArray array;
     for(const auto& camName : _selectedCameras)
     {
-        _camerasByName[camName.toStdString()]->getCamera().getVisibleIndexes(array);
-        for(unsigned int i=0; i<array.length(); ++i)
-            points.insert(array[i]);
+        const MVGCamera& camera = _camerasByName[camName.toStdString()]->getCamera();
+        const int slot = _visibilityIndex.getSlot(camera.getId());
+        const int* slotPoints = nullptr;
+        const int count = _visibilityIndex.getPoints(slot, slotPoints);
+        points.insert(slotPoints, slotPoints + count);
     }
     // Activate particle selection mode
     setUseParticleSelection(true);
@@ -917,6 +974,10 @@ void MVGProjectWrapper::clear()
     _meshesList.clear();
     _selectedMeshes.clear();
 
+    _visibilityIndex.clear();
+    _camerasPerSlot.clear();
+    _pointCoverage.clear();
+
     if(_cameraPointsLocatorCB)
         MNodeMessage::removeCallback(_cameraPointsLocatorCB);
 
@@ -946,8 +1007,68 @@ void MVGProjectWrapper::clearAndUnloadImageCache()
     _project.clearImageCache();
 }
 
+/**
+ * Candidates are, by decreasing priority: the next and previous cameras in the current camera
+ * set, then the cameras sharing the most points with this one. The images are loaded on idle,
+ * within the free memory of the image cache.
+ */
+void MVGProjectWrapper::prefetchNeighbourImages(const MVGCameraWrapper& cameraWrapper)
+{
+    // Number of co-visible cameras to prefetch
+    const size_t neighbourCount = 2;
+
+    std::vector<std::string> cameraNames;
+    auto addCamera = [&](const MVGCameraWrapper* wrapper)
+    {
+        if(!wrapper || wrapper == &cameraWrapper)
+            return;
+        const std::string name = wrapper->getCamera().getName();
+        if(std::find(cameraNames.begin(), cameraNames.end(), name) == cameraNames.end())
+            cameraNames.push_back(name);
+    };
+
+    // Neighbours in the camera list
+    if(_currentCameraSet)
+    {
+        const QObjectListModel* cameras = _currentCameraSet->getCameras();
+        const int index = cameras->indexOf(const_cast<MVGCameraWrapper*>(&cameraWrapper));
+        if(index >= 0 && index + 1 < cameras->count())
+            addCamera(qobject_cast<MVGCameraWrapper*>(cameras->at(index + 1)));
+        if(index > 0)
+            addCamera(qobject_cast<MVGCameraWrapper*>(cameras->at(index - 1)));
+    }
+
+    // Co-visible cameras
+    const int slot = _visibilityIndex.getSlot(cameraWrapper.getCamera().getId());
+    if(slot >= 0)
+    {
+        const int* points = nullptr;
+        const int pointCount = _visibilityIndex.getPoints(slot, points);
+        std::vector<int> commonPointsPerSlot;
+        _visibilityIndex.countPointsPerCamera(std::vector<int>(points, points + pointCount),
+                                              commonPointsPerSlot);
+        commonPointsPerSlot[slot] = 0;
+        std::vector<std::pair<int, int>> slotsByCommonPoints; // (-count, slot)
+        for(size_t i = 0; i < commonPointsPerSlot.size(); ++i)
+        {
+            if(commonPointsPerSlot[i] > 0 && _camerasPerSlot[i])
+                slotsByCommonPoints.push_back(
+                    std::make_pair(-commonPointsPerSlot[i], static_cast<int>(i)));
+        }
+        const size_t count = std::min(neighbourCount, slotsByCommonPoints.size());
+        std::partial_sort(slotsByCommonPoints.begin(), slotsByCommonPoints.begin() + count,
+                          slotsByCommonPoints.end());
+        for(size_t i = 0; i < count; ++i)
+            addCamera(_camerasPerSlot[slotsByCommonPoints[i].second]);
+    }
+
+    _project.pushPrefetchImagePlaneCommands(cameraNames);
+}
+
 void MVGProjectWrapper::clearCameraSelection()
 {
+    if(_selectedCameras.empty())
+        return;
     for(QStringList::const_iterator it = _selectedCameras.begin(); it != _selectedCameras.end();
         ++it)
     {
@@ -962,6 +1083,8 @@ void MVGProjectWrapper::clearCameraSelection()
 
 void MVGProjectWrapper::clearMeshSelection()
 {
+    if(_selectedMeshes.empty())
+        return;
     for(QStringList::const_iterator it = _selectedMeshes.begin(); it != _selectedMeshes.end(); ++it)
     {
         std::map<std::string, MVGMeshWrapper*>::const_iterator foundIt =
@@ -988,6 +1111,9 @@ void MVGProjectWrapper::removeCameraFromUI(MObject& camera)
     _camerasByName.erase(camName);
 
     auto* wrapper = it->second;
+    // The wrapper may be deleted with the camera : clear its visibility slot
+    std::replace(_camerasPerSlot.begin(), _camerasPerSlot.end(), wrapper,
+                 static_cast<MVGCameraWrapper*>(nullptr));
     // Remove all occurences of the wrapper in the camera sets
     for (MVGCameraSetWrapper* setWrapper : _cameraSets.asQList<MVGCameraSetWrapper>())
     {
@@ -1107,26 +1233,29 @@ void MVGProjectWrapper::reloadMVGCamerasFromMaya()
 {
     _camerasByName.clear();
     _activeCameraNameByView.clear();
-    _camerasPerPoint.clear();
+    _camerasPerSlot.clear();
     _cameraSetsByName.clear();
     _cameraSets.clear();
-    _selectionScorePerCamera.clear();
+    _selectionScorePerSlot.clear();
 
     const std::vector<MVGCamera>& cameraList = MVGCamera::getCameras();
+    // Already built when loading an Alembic file
+    if(_visibilityIndex.isEmpty())
+        loadVisibilityIndex(cameraList);
+    _camerasPerSlot.assign(_visibilityIndex.getCameraCount(), nullptr);
     QObjectList camWrappers;
+    QStringList dagPaths;
+    QStringList imagePaths;
     for(const auto& camera : cameraList)
     {
         MVGCameraWrapper* cameraWrapper = new MVGCameraWrapper(camera);
         camWrappers.append(cameraWrapper);
+        dagPaths.append(cameraWrapper->getDagPathAsString());
+        imagePaths.append(cameraWrapper->getImagePath());
         _camerasByName[camera.getDagPathAsString()] = cameraWrapper;
-        MIntArray indices;
-        camera.getVisibleIndexes(indices);
-        for(unsigned int i = 0; i < indices.length(); ++i)
-        {
-            if(!_camerasPerPoint.count(indices[i]))
-                _camerasPerPoint.emplace(indices[i], std::vector<MVGCameraWrapper*>());
-            _camerasPerPoint[indices[i]].push_back(cameraWrapper);
-        }
+        const int slot = _visibilityIndex.getSlot(camera.getId());
+        if(slot >= 0)
+            _camerasPerSlot[slot] = cameraWrapper;
         MObject cam = camera.getObject();
         // Lock cam node to avoid manipulation errors
         MFnDagNode dagCam(cam);
@@ -1138,6 +1267,9 @@ void MVGProjectWrapper::reloadMVGCamerasFromMaya()
         _nodeCallbacks[camera.getName()].append(cbId);
     }
     // TODO : Camera selection
+    // Image metadata and thumbnails, read in background to never block on slow file systems
+    MVGImageInfoScanner::scan(dagPaths, imagePaths, this, "setCameraSourceInfo");
+    MVGThumbnailCache::generateThumbnails(imagePaths, MVGThumbnailCache::_DEFAULT_SIZE);
 
     // Camera Sets
     {
@@ -1152,6 +1284,40 @@ void MVGProjectWrapper::reloadMVGCamerasFromMaya()
     }
 }
 
+/**
+ * Result of the background scan started by reloadMVGCamerasFromMaya
+ */
+void MVGProjectWrapper::setCameraSourceInfo(const QString& dagPath, const QSize& size,
+                                            const qint64 weight)
+{
+    std::map<std::string, MVGCameraWrapper*>::const_iterator it =
+        _camerasByName.find(dagPath.toStdString());
+    if(it == _camerasByName.end())
+        return;
+    it->second->setSourceInfo(size, weight);
+}
+
+void MVGProjectWrapper::loadVisibilityIndex(const std::vector<MVGCamera>& cameras)
+{
+    _pointCoverage.clear();
+    MVGPointCloud pointCloud(MVGProject::_CLOUD);
+    if(pointCloud.isValid() && pointCloud.getVisibility(_visibilityIndex))
+        return;
+    // Fallback on the visible items stored on cameras
+    _visibilityIndex.clear();
+    MIntArray indices;
+    for(const auto& camera : cameras)
+    {
+        camera.getVisibleIndexes(indices);
+        if(indices.length() == 0)
+            continue;
+        std::vector<int> points(indices.length());
+        indices.get(&points[0]);
+        _visibilityIndex.addCamera(camera.getId(), &points[0], points.size());
+    }
+    _visibilityIndex.buildFromCameras();
+}
+
 void MVGProjectWrapper::updatePanelColor(const QString& viewName)
 {
     // Update panel's color
@@ -1174,30 +1340,38 @@ void MVGProjectWrapper::updateCamerasFromParticleSelection(bool force)
 
     if(!_particleSelection.empty())
     {
-        const auto maxIt = std::max_element(_selectionScorePerCamera.begin(), _selectionScorePerCamera.end(),
-                [](const std::pair<MVGCameraWrapper*, int>& p1, const std::pair<MVGCameraWrapper*, int>& p2)
-                {
-                    return p1.second < p2.second;
-                });
-        setParticleMaxAccuracy(maxIt->second);
+        int maxScore = 0;
+        for(size_t slot = 0; slot < _selectionScorePerSlot.size(); ++slot)
+        {
+            if(_camerasPerSlot[slot])
+                maxScore = std::max(maxScore, _selectionScorePerSlot[slot]);
+        }
+        setParticleMaxAccuracy(maxScore);
         const auto minAccuracy = getParticleMaxAccuracy() * (_particleSelectionAccuracy/100.0f);
 
-        // Keep only cameras meeting the minimum score requirement
-        for(const auto& elt : _selectionScorePerCamera)
+        // Keep only cameras meeting the minimum score requirement, as (score, slot) pairs
+        std::vector<std::pair<int, int>> scoredSlots;
+        for(size_t slot = 0; slot < _selectionScorePerSlot.size(); ++slot)
         {
-            if(elt.second >= minAccuracy)
-                filteredCams.append(elt.first);
+            const int score = _selectionScorePerSlot[slot];
+            if(score > 0 && score >= minAccuracy && _camerasPerSlot[slot])
+                scoredSlots.emplace_back(score, slot);
         }
 
         // Unless forced to update, same size here means no changes
-        if(!force && filteredCams.size() == _particleSelectionCameraSet->getCameras()->size())
+        const int selectionCameraCount = _particleSelectionCameraSet->getCameras()->size();
+        if(!force && static_cast<int>(scoredSlots.size()) == selectionCameraCount)
             return;
 
         // Sort model by score
-        std::sort(filteredCams.begin(), filteredCams.end(),
-                [this](QObject* a, QObject* b){
-                   return _selectionScorePerCamera[static_cast<MVGCameraWrapper*>(a)] > _selectionScorePerCamera[static_cast<MVGCameraWrapper*>(b)];
+        std::sort(scoredSlots.begin(), scoredSlots.end(),
+                [](const std::pair<int, int>& a, const std::pair<int, int>& b)
+                {
+                    return a.first > b.first || (a.first == b.first && a.second < b.second);
                 });
+        filteredCams.reserve(scoredSlots.size());
+        for(const auto& scoredSlot : scoredSlots)
+            filteredCams.append(_camerasPerSlot[scoredSlot.second]);
     }
 
     _particleSelectionCameraSet->highlightLocators(false);
@@ -6,6 +6,8 @@
 #include "mayaMVG/qt/MVGCameraSetWrapper.hpp"
 #include "mayaMVG/qt/MVGMeshWrapper.hpp"
 #include "mayaMVG/core/MVGProject.hpp"
+#include "mayaMVG/geometry/MVGVisibilityIndex.hpp"
+#include "mayaMVG/geometry/MVGPointCoverage.hpp"
 #include "maya/MDistance.h"
 #include <QObject>
 #include <set>
@@ -99,7 +101,7 @@ public Q_SLOTS:
         Q_EMIT particleMaxAccuracyChanged();
     }
 
-    void updateParticleSelection(const std::set<int>& selection);
+    void updateParticleSelection(const std::vector<int>& selection);
 
     int getParticleSelectionAccuracy() const { return _particleSelectionAccuracy; }
     void setParticleSelectionAccuracy(int value) {
@@ -206,20 +208,26 @@ public:
     void setEditMode(const int mode);
     void setMoveMode(const int mode);
     void updatePanelColor(const QString& viewName);
+    void queueMayaSelectionUpdate();
     
 protected Q_SLOTS:
     void updateParticlesOpacity();
+    void updateFromMayaSelection();
+    void setCameraSourceInfo(const QString& dagPath, const QSize& size, const qint64 weight);
 
 private:
     void initCameraPointsLocator();
     void updatePointsVisibility();
     void reloadMVGCamerasFromMaya();
+    void loadVisibilityIndex(const std::vector<MVGCamera>& cameras);
     /// Update members of the camera set based on particle selection
     void updateCamerasFromParticleSelection(bool force=false);
     /// Update set's MVGCameraSetWrapper members (MVGCameraWrappers)
     void updateCameraSetWrapperMembers(const MObject &set);
     /// Use 'wrapper' as current camera set
     void setCurrentCameraSet(MVGCameraSetWrapper *wrapper);
+    /// Load ahead of time the images of the cameras likely to be displayed after this one
+    void prefetchNeighbourImages(const MVGCameraWrapper& cameraWrapper);
     MVGCameraWrapper* cameraFromViewName(const QString& viewName);
     MVGPanelWrapper* panelFromViewName(const QString& viewName);
 
@@ -239,11 +247,22 @@ private:
     int _moveMode;
     bool _isProjectLoading;
     bool _activeSynchro;
+    /// Maya selection changes are coalesced into one update (see queueMayaSelectionUpdate)
+    bool _isMayaSelectionUpdateQueued;
+    /// Particle ids of the Maya selection, kept to reuse its allocation
+    std::vector<int> _mayaSelectedParticles;
 
     int _currentCameraSetId;
-    std::set<int> _particleSelection;
-    std::map<MVGCameraWrapper*, int> _selectionScorePerCamera;
-    std::map<int, std::vector<MVGCameraWrapper*>> _camerasPerPoint;
+    /// Selected particle ids, sorted
+    std::vector<int> _particleSelection;
+    /// Number of selected particles seen by each visibility index camera slot
+    std::vector<int> _selectionScorePerSlot;
+    /// Point cloud visibility, shared by particle selection and points filtering
+    MVGVisibilityIndex _visibilityIndex;
+    /// Camera wrapper of each visibility index camera slot (may be null)
+    std::vector<MVGCameraWrapper*> _camerasPerSlot;
+    /// Number of cameras of the current camera set seeing each point, for points filtering
+    MVGPointCoverage _pointCoverage;
     int _particleSelectionAccuracy;
     int _particleMaxAccuracy;
     bool _filterPoints;
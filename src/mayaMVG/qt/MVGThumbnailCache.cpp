@@ -0,0 +1,241 @@
+#include "mayaMVG/qt/MVGThumbnailCache.hpp"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <QThreadPool>
+#include <QtGlobal>
+#include <algorithm>
+
+namespace mayaMVG
+{
+
+namespace
+{ // empty namespace
+
+// Number of bytes of the source image used to compute the cache key
+const qint64 contentKeySize = 64 * 1024;
+// Disk space used by the cache above which the least recently used files are removed
+const qint64 maxCacheSize = 512 * 1024 * 1024;
+
+QThreadPool& getThreadPool()
+{
+    static QThreadPool threadPool;
+    static bool initialized = false;
+    if(!initialized)
+    {
+        // Keep one core for Maya
+        threadPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+        initialized = true;
+    }
+    return threadPool;
+}
+
+class ThumbnailTask : public QRunnable
+{
+public:
+    ThumbnailTask(const QString& imagePath, const int size)
+        : _imagePath(imagePath)
+        , _size(size)
+    {
+    }
+    void run() override { MVGThumbnailCache::getThumbnail(_imagePath, _size); }
+
+private:
+    const QString _imagePath;
+    const int _size;
+};
+
+/**
+ * Record an access to a cached file in its modification time, the access time being often not
+ * updated by the file system.
+ */
+void touchFile(const QString& path)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::ReadWrite))
+        return;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+#else
+    // Write back the first byte
+    char c;
+    if(file.getChar(&c) && file.seek(0))
+        file.putChar(c);
+#endif
+}
+
+bool isLessRecentlyUsed(const QFileInfo& lhs, const QFileInfo& rhs)
+{
+    return lhs.lastModified() < rhs.lastModified();
+}
+
+} // empty namespace
+
+const int MVGThumbnailCache::_DEFAULT_SIZE = 512;
+
+/**
+ * @return the image dimensions, read from the image header only
+ */
+QSize MVGThumbnailCache::readImageSize(const QString& imagePath)
+{
+    QImageReader reader(imagePath);
+    return reader.size();
+}
+
+/**
+ * Round the requested size up to a power of two, so that the slider of the camera list does
+ * not create a new thumbnail for each size.
+ * @return the maximum width and height of the thumbnail
+ */
+int MVGThumbnailCache::getThumbnailSize(const QSize& requestedSize)
+{
+    const int requested = std::max(requestedSize.width(), requestedSize.height());
+    if(requested <= 0)
+        return _DEFAULT_SIZE;
+    int size = 64;
+    while(size < requested && size < 2048)
+        size *= 2;
+    return size;
+}
+
+/**
+ * @param[in] imagePath : source image
+ * @param[in] size : maximum width and height of the thumbnail
+ * @return the cached thumbnail, generated if needed. Thread safe.
+ */
+QImage MVGThumbnailCache::getThumbnail(const QString& imagePath, const int size)
+{
+    const QString thumbnailPath = getThumbnailPath(imagePath, size);
+    QImage thumbnail;
+    if(!thumbnailPath.isEmpty() && thumbnail.load(thumbnailPath))
+    {
+        touchFile(thumbnailPath);
+        return thumbnail;
+    }
+
+    thumbnail = createThumbnail(imagePath, size);
+    if(thumbnail.isNull() || thumbnailPath.isEmpty())
+        return thumbnail;
+    // Atomic write: the same thumbnail may be generated by several threads
+    QSaveFile file(thumbnailPath);
+    if(file.open(QIODevice::WriteOnly) && thumbnail.save(&file, "JPG", 90))
+        file.commit();
+    return thumbnail;
+}
+
+/**
+ * Generate the missing thumbnails on worker threads. The cache is trimmed first, once the
+ * running generations are done, so that it never removes a thumbnail being written.
+ * @param[in] imagePaths : source images
+ * @param[in] size : maximum width and height of the thumbnails
+ */
+void MVGThumbnailCache::generateThumbnails(const QStringList& imagePaths, const int size)
+{
+    QThreadPool& threadPool = getThreadPool();
+    threadPool.waitForDone();
+    trimCache(maxCacheSize);
+    for(QStringList::const_iterator it = imagePaths.begin(); it != imagePaths.end(); ++it)
+        threadPool.start(new ThumbnailTask(*it, size));
+}
+
+/**
+ * Remove the least recently used files of the cache until it uses at most maxSize bytes.
+ * Thumbnails are touched on each read (see getThumbnail), key files only when written.
+ * Files removed while in use are generated again on next request.
+ */
+void MVGThumbnailCache::trimCache(const qint64 maxSize)
+{
+    QFileInfoList files = QDir(getCacheDirectory()).entryInfoList(QDir::Files);
+    qint64 cacheSize = 0;
+    for(QFileInfoList::const_iterator it = files.begin(); it != files.end(); ++it)
+        cacheSize += it->size();
+    if(cacheSize <= maxSize)
+        return;
+    std::sort(files.begin(), files.end(), isLessRecentlyUsed);
+    for(QFileInfoList::const_iterator it = files.begin(); it != files.end(); ++it)
+    {
+        if(cacheSize <= maxSize)
+            break;
+        if(QFile::remove(it->absoluteFilePath()))
+            cacheSize -= it->size();
+    }
+}
+
+/**
+ * Remove the pending generations and wait for the running ones
+ */
+void MVGThumbnailCache::cancelThumbnailsGeneration()
+{
+    QThreadPool& threadPool = getThreadPool();
+    threadPool.clear();
+    threadPool.waitForDone();
+}
+
+QString MVGThumbnailCache::getCacheDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+           "/mayaMVG/thumbnails";
+}
+
+/**
+ * The cache key of an image is a hash of its first bytes, computed once per file version: it is
+ * stored in a key file named after the path, size and modification time of the image.
+ * @return the path of the thumbnail in the cache, empty if the source image cannot be read
+ */
+QString MVGThumbnailCache::getThumbnailPath(const QString& imagePath, const int size)
+{
+    const QFileInfo info(imagePath);
+    if(!info.isFile())
+        return QString();
+    const QString directory = getCacheDirectory();
+    if(!QDir().mkpath(directory))
+        return QString();
+
+    QCryptographicHash fileHash(QCryptographicHash::Sha1);
+    fileHash.addData(info.absoluteFilePath().toUtf8());
+    fileHash.addData(QByteArray::number(info.size()));
+    fileHash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    const QString keyPath = QString("%1/%2.key").arg(directory, QString(fileHash.result().toHex()));
+
+    QByteArray contentKey;
+    QFile keyFile(keyPath);
+    if(keyFile.open(QIODevice::ReadOnly))
+        contentKey = keyFile.readAll();
+    if(contentKey.isEmpty())
+    {
+        // Only read the image on a miss, the file system may be slow
+        QFile file(imagePath);
+        if(!file.open(QIODevice::ReadOnly))
+            return QString();
+        QCryptographicHash contentHash(QCryptographicHash::Sha1);
+        contentHash.addData(QByteArray::number(file.size()));
+        contentHash.addData(file.read(contentKeySize));
+        contentKey = contentHash.result().toHex();
+        QSaveFile newKeyFile(keyPath);
+        if(newKeyFile.open(QIODevice::WriteOnly) && newKeyFile.write(contentKey) > 0)
+            newKeyFile.commit();
+    }
+    return QString("%1/%2-%3.jpg").arg(directory, QString(contentKey)).arg(size);
+}
+
+/**
+ * Decode the source image directly at the thumbnail resolution, when the format allows it
+ * (JPEG).
+ */
+QImage MVGThumbnailCache::createThumbnail(const QString& imagePath, const int size)
+{
+    QImageReader reader(imagePath);
+    const QSize sourceSize = reader.size();
+    if(sourceSize.isValid() && (sourceSize.width() > size || sourceSize.height() > size))
+        reader.setScaledSize(sourceSize.scaled(size, size, Qt::KeepAspectRatio));
+    return reader.read();
+}
+
+} // namespace
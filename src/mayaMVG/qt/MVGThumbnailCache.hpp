@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QImage>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+
+namespace mayaMVG
+{
+
+/**
+ * Downscaled images of the cameras, for the camera list.
+ * Thumbnails are generated once and persisted in an on-disk cache, keyed by the content of the
+ * source image: they survive project reloads and path remapping. The least recently used files
+ * are removed when the cache grows too large.
+ */
+class MVGThumbnailCache
+{
+public:
+    static QSize readImageSize(const QString& imagePath);
+    static int getThumbnailSize(const QSize& requestedSize);
+    static QImage getThumbnail(const QString& imagePath, const int size);
+    static void generateThumbnails(const QStringList& imagePaths, const int size);
+    static void cancelThumbnailsGeneration();
+    static void trimCache(const qint64 maxSize);
+    static QString getCacheDirectory();
+
+private:
+    static QString getThumbnailPath(const QString& imagePath, const int size);
+    static QImage createThumbnail(const QString& imagePath, const int size);
+
+public:
+    /// Thumbnail size when none is requested, also the one requested by CameraThumbnail.qml
+    static const int _DEFAULT_SIZE;
+};
+
+} // namespace
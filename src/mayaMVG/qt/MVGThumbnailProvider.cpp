@@ -0,0 +1,32 @@
+#include "mayaMVG/qt/MVGThumbnailProvider.hpp"
+#include "mayaMVG/qt/MVGThumbnailCache.hpp"
+#include <QUrl>
+
+namespace mayaMVG
+{
+
+QString MVGThumbnailProvider::_NAME = "mvgThumbnail";
+
+MVGThumbnailProvider::MVGThumbnailProvider()
+    : QQuickImageProvider(QQuickImageProvider::Image)
+{
+}
+
+/**
+ * Called from the QML image loading thread for asynchronous images.
+ * @param[in] id : percent encoded path of the source image
+ * @param[out] size : size of the returned thumbnail
+ * @param[in] requestedSize : Image.sourceSize
+ */
+QImage MVGThumbnailProvider::requestImage(const QString& id, QSize* size,
+                                          const QSize& requestedSize)
+{
+    const QString imagePath = QUrl::fromPercentEncoding(id.toUtf8());
+    const QImage thumbnail = MVGThumbnailCache::getThumbnail(
+        imagePath, MVGThumbnailCache::getThumbnailSize(requestedSize));
+    if(size)
+        *size = thumbnail.size();
+    return thumbnail;
+}
+
+} // namespace
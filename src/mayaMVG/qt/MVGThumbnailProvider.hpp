@@ -0,0 +1,24 @@
+#pragma once
+
+#include <QQuickImageProvider>
+
+namespace mayaMVG
+{
+
+/**
+ * Serve the camera thumbnails to QML, from the MVGThumbnailCache.
+ * Usage: "image://mvgThumbnail/" + encodeURIComponent(imagePath)
+ */
+class MVGThumbnailProvider : public QQuickImageProvider
+{
+public:
+    MVGThumbnailProvider();
+
+public:
+    QImage requestImage(const QString& id, QSize* size, const QSize& requestedSize) override;
+
+public:
+    static QString _NAME;
+};
+
+} // namespace
@@ -133,7 +133,8 @@ Rectangle {
             }*/
             // file weight
             Text {
-                text: convertWeight(m.camera.sourceWeight)
+                // -1 until read in background
+                text: (m.camera.sourceWeight < 0) ? "..." : convertWeight(m.camera.sourceWeight)
                 color: "#888888"
             }
         }
@@ -25,7 +25,9 @@ Rectangle {
             anchors.fill: parent
             // Add 2 margin to add a correct resizing interpolation
             sourceSize.width: settings.sliderMaxValue * 2 // Use proxy buffer at smaller resolution
-            source: m.camera ? m.camera.imagePath : m.source
+            // Thumbnails are generated once and cached on disk (see MVGThumbnailProvider)
+            source: m.camera ? "image://mvgThumbnail/" + encodeURIComponent(m.camera.imagePath)
+                             : m.source
             asynchronous: true
             cache: true
             // fillMode: Image.PreserveAspectFit
@@ -0,0 +1,731 @@
+#include "mayaMVG/geometry/MVGGeometry.hpp"
+#include "mayaMVG/geometry/MVGCameraIndex.hpp"
+#include "mayaMVG/geometry/MVGObservationTable.hpp"
+#include "mayaMVG/geometry/MVGPointCoverage.hpp"
+#include "mayaMVG/geometry/MVGVisibilityIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Unit tests of the geometry library, run on synthetic data.
+ * Usage: mayaMVGGeometryTest [filter] (only run tests whose name contains filter)
+ * Returns the number of failed tests.
+ */
+
+using namespace mayaMVG;
+
+namespace
+{ // empty namespace
+
+int g_failedChecks = 0;
+
+#define EXPECT_TRUE(condition)                                                                     \
+    if(!(condition))                                                                               \
+    {                                                                                              \
+        std::printf("  %s:%d: expected %s\n", __FILE__, __LINE__, #condition);                    \
+        ++g_failedChecks;                                                                          \
+    }
+
+#define EXPECT_NEAR(a, b, tolerance)                                                               \
+    if(!(std::abs((a) - (b)) <= (tolerance)))                                                      \
+    {                                                                                              \
+        std::printf("  %s:%d: expected %s == %s (%g != %g, tolerance %g)\n", __FILE__, __LINE__,  \
+                    #a, #b, static_cast<double>(a), static_cast<double>(b),                        \
+                    static_cast<double>(tolerance));                                               \
+        ++g_failedChecks;                                                                          \
+    }
+
+/// Ideal pinhole camera looking down +Z, principal point at the image center
+aliceVision::Mat34 makeCamera(const double focalLength, const aliceVision::Vec3& center,
+                              const aliceVision::Mat3& rotation = aliceVision::Mat3::Identity())
+{
+    aliceVision::Mat3 K;
+    K << focalLength, 0.0, 500.0, 0.0, focalLength, 500.0, 0.0, 0.0, 1.0;
+    aliceVision::Mat34 P;
+    MVGGeometry::computeProjectionMatrix(K, rotation, center, P);
+    return P;
+}
+
+aliceVision::Vec2 project(const aliceVision::Mat34& P, const aliceVision::Vec3& point)
+{
+    const aliceVision::Vec3 x = P * point.homogeneous();
+    return x.head<2>() / x(2);
+}
+
+/// Points of the plane z = 0.5 x - 0.25 y + 2 (one point per column), in [-1, 1] x [-1, 1]
+aliceVision::Mat makePlanePoints(const int count, std::mt19937& generator)
+{
+    std::uniform_real_distribution<double> coordinate(-1.0, 1.0);
+    aliceVision::Mat points(3, count);
+    for(int i = 0; i < count; ++i)
+    {
+        points(0, i) = coordinate(generator);
+        points(1, i) = coordinate(generator);
+        points(2, i) = 0.5 * points(0, i) - 0.25 * points(1, i) + 2.0;
+    }
+    return points;
+}
+
+/// Distance from the point to the plane, the plane normal not being assumed normalized
+double planeDistance(const aliceVision::Vec4& plane, const aliceVision::Vec3& point)
+{
+    return std::abs(plane.head<3>().dot(point) + plane(3)) / plane.head<3>().norm();
+}
+
+void testComputeProjectionMatrix()
+{
+    const aliceVision::Mat34 P = makeCamera(1000.0, aliceVision::Vec3(1.0, 2.0, -10.0));
+    // point on the optical axis, projected on the principal point
+    const aliceVision::Vec2 center = project(P, aliceVision::Vec3(1.0, 2.0, 5.0));
+    EXPECT_NEAR(center(0), 500.0, 1e-9)
+    EXPECT_NEAR(center(1), 500.0, 1e-9)
+    // x = f * X / Z + cx
+    const aliceVision::Vec2 x = project(P, aliceVision::Vec3(2.0, 2.5, 0.0));
+    EXPECT_NEAR(x(0), 600.0, 1e-9)
+    EXPECT_NEAR(x(1), 550.0, 1e-9)
+}
+
+void testTriangulatePoint()
+{
+    const double angle = 0.2;
+    aliceVision::Mat3 rotation;
+    rotation << std::cos(angle), 0.0, -std::sin(angle), 0.0, 1.0, 0.0, std::sin(angle), 0.0,
+        std::cos(angle);
+    std::vector<aliceVision::Mat34> projectionMatrices;
+    projectionMatrices.push_back(makeCamera(1000.0, aliceVision::Vec3(0.0, 0.0, -10.0)));
+    projectionMatrices.push_back(makeCamera(1200.0, aliceVision::Vec3(3.0, 0.5, -9.0), rotation));
+    projectionMatrices.push_back(makeCamera(800.0, aliceVision::Vec3(-2.0, 1.0, -11.0)));
+
+    const aliceVision::Vec3 point(0.5, 0.3, 2.0);
+    for(size_t cameraCount = 2; cameraCount <= projectionMatrices.size(); ++cameraCount)
+    {
+        const std::vector<aliceVision::Mat34> cameras(projectionMatrices.begin(),
+                                                      projectionMatrices.begin() + cameraCount);
+        aliceVision::Mat2X imagePoints(2, cameraCount);
+        for(size_t i = 0; i < cameraCount; ++i)
+            imagePoints.col(i) = project(cameras[i], point);
+        aliceVision::Vec3 triangulatedPoint;
+        EXPECT_TRUE(MVGGeometry::triangulatePoint(imagePoints, cameras, triangulatedPoint))
+        EXPECT_NEAR((triangulatedPoint - point).norm(), 0.0, 1e-6)
+    }
+}
+
+void testViewAndCameraSpace()
+{
+    MVGViewProjection projection;
+    projection.viewportWidth = 100.0;
+    projection.viewportHeight = 100.0;
+    projection.portWidth = 100.0;
+    projection.portHeight = 100.0;
+
+    // identity world to clip matrix
+    aliceVision::Vec2 viewPoint;
+    MVGGeometry::worldToViewSpace(projection, aliceVision::Vec3(0.5, -0.5, 0.0), viewPoint);
+    EXPECT_NEAR(viewPoint(0), 75.0, 1e-9)
+    EXPECT_NEAR(viewPoint(1), 25.0, 1e-9)
+    aliceVision::Vec2 cameraPoint;
+    MVGGeometry::viewToCameraSpace(projection, viewPoint, cameraPoint);
+    EXPECT_NEAR(cameraPoint(0), 0.25, 1e-9)
+    EXPECT_NEAR(cameraPoint(1), -0.25, 1e-9)
+    aliceVision::Vec2 imagePoint;
+    MVGGeometry::cameraToImageSpace(1.0, 100.0, 50.0, cameraPoint, imagePoint);
+    EXPECT_NEAR(imagePoint(0), 75.0, 1e-9)
+    EXPECT_NEAR(imagePoint(1), 50.0, 1e-9)
+
+    // batched projections match the point by point ones, with a perspective matrix
+    projection.worldToClip[2][3] = 0.5;
+    projection.worldToClip[3][0] = 0.1;
+    projection.filmScale = 1.5;
+    projection.horizontalPan = 0.2;
+    projection.verticalPan = -0.1;
+    projection.portHeight = 80.0;
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> coordinate(-1.0, 1.0);
+    aliceVision::Mat3X worldPoints(3, 50);
+    for(int i = 0; i < worldPoints.cols(); ++i)
+        worldPoints.col(i) << coordinate(generator), coordinate(generator), coordinate(generator);
+    aliceVision::Mat2X viewPoints;
+    MVGGeometry::worldToViewSpace(projection, worldPoints, viewPoints);
+    std::vector<double> xs, ys;
+    MVGGeometry::worldToCameraSpace(projection, worldPoints, xs, ys);
+    EXPECT_TRUE(viewPoints.cols() == worldPoints.cols())
+    EXPECT_TRUE(static_cast<int>(xs.size()) == worldPoints.cols())
+    for(int i = 0; i < worldPoints.cols(); ++i)
+    {
+        MVGGeometry::worldToViewSpace(projection, aliceVision::Vec3(worldPoints.col(i)),
+                                      viewPoint);
+        EXPECT_NEAR(viewPoints(0, i), viewPoint(0), 1e-9)
+        EXPECT_NEAR(viewPoints(1, i), viewPoint(1), 1e-9)
+        MVGGeometry::viewToCameraSpace(projection, viewPoint, cameraPoint);
+        EXPECT_NEAR(xs[i], cameraPoint(0), 1e-9)
+        EXPECT_NEAR(ys[i], cameraPoint(1), 1e-9)
+    }
+}
+
+void testWindingNumber()
+{
+    // counterclockwise square, first vertex repeated at the end
+    aliceVision::Mat2X square(2, 5);
+    square << 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0;
+    EXPECT_TRUE(MVGGeometry::windingNumber(aliceVision::Vec2(0.5, 0.5), square) == 1)
+    EXPECT_TRUE(MVGGeometry::windingNumber(aliceVision::Vec2(1.5, 0.5), square) == 0)
+    EXPECT_TRUE(MVGGeometry::windingNumber(aliceVision::Vec2(0.5, -0.5), square) == 0)
+    aliceVision::Mat2X clockwiseSquare = square.rowwise().reverse();
+    EXPECT_TRUE(MVGGeometry::windingNumber(aliceVision::Vec2(0.5, 0.5), clockwiseSquare) == -1)
+
+    // batched test matches the point by point one
+    aliceVision::Mat2X points(2, 121);
+    for(int i = 0; i < 11; ++i)
+        for(int j = 0; j < 11; ++j)
+            points.col(i * 11 + j) << -0.25 + 0.15 * i, -0.25 + 0.15 * j;
+    Eigen::ArrayXi windingNumbers;
+    MVGGeometry::windingNumbers(points, square, windingNumbers);
+    EXPECT_TRUE(windingNumbers.size() == points.cols())
+    int insideCount = 0;
+    for(int i = 0; i < points.cols(); ++i)
+    {
+        const int expected = MVGGeometry::windingNumber(aliceVision::Vec2(points.col(i)), square);
+        EXPECT_TRUE(windingNumbers(i) == expected)
+        insideCount += (expected != 0);
+    }
+    // x and y in {0.05, 0.2, ..., 0.95}
+    EXPECT_TRUE(insideCount == 49)
+}
+
+void testPlaneKernel()
+{
+    std::mt19937 generator(3);
+    const aliceVision::Mat points = makePlanePoints(100, generator);
+    const PlaneKernel kernel(points);
+    EXPECT_TRUE(kernel.NumSamples() == 100)
+
+    std::vector<size_t> samples;
+    samples.push_back(0);
+    samples.push_back(10);
+    samples.push_back(20);
+    std::vector<PlaneKernel::Model> models;
+    kernel.Fit(samples, &models);
+    EXPECT_TRUE(models.size() == 1)
+    if(models.empty())
+        return;
+    EXPECT_NEAR(models[0].head<3>().norm(), 1.0, 1e-9)
+    for(size_t i = 0; i < kernel.NumSamples(); ++i)
+        EXPECT_NEAR(kernel.Error(i, models[0]), 0.0, 1e-9)
+
+    // collinear samples are rejected
+    aliceVision::Mat collinearPoints(3, 3);
+    collinearPoints << 0.0, 1.0, 2.0, 0.0, 2.0, 4.0, 0.0, 3.0, 6.0;
+    const PlaneKernel collinearKernel(collinearPoints);
+    std::vector<size_t> allSamples;
+    for(size_t i = 0; i < 3; ++i)
+        allSamples.push_back(i);
+    collinearKernel.Fit(allSamples, &models);
+    EXPECT_TRUE(models.empty())
+
+    // least squares refinement on noisy points
+    std::normal_distribution<double> noise(0.0, 0.001);
+    aliceVision::Mat noisyPoints = points;
+    for(int i = 0; i < noisyPoints.cols(); ++i)
+        noisyPoints(2, i) += noise(generator);
+    const PlaneKernel noisyKernel(noisyPoints);
+    allSamples.clear();
+    for(size_t i = 0; i < noisyKernel.NumSamples(); ++i)
+        allSamples.push_back(i);
+    PlaneKernel::Model refined(0.0, 0.0, 1.0, 0.0);
+    noisyKernel.Refine(allSamples, &refined);
+    for(int i = 0; i < points.cols(); ++i)
+        EXPECT_NEAR(planeDistance(refined, points.col(i)), 0.0, 0.005)
+}
+
+void testLineConstrainedPlaneKernel()
+{
+    std::mt19937 generator(5);
+    const aliceVision::Mat points = makePlanePoints(20, generator);
+    // line of the plane z = 0.5 x - 0.25 y + 2, at y = 0
+    const aliceVision::Vec3 constraintP0(-1.0, 0.0, 1.5);
+    const aliceVision::Vec3 constraintP1(1.0, 0.0, 2.5);
+    const LineConstrainedPlaneKernel kernel(points, constraintP0, constraintP1);
+
+    std::vector<size_t> samples(1, 3);
+    std::vector<LineConstrainedPlaneKernel::Model> models;
+    kernel.Fit(samples, &models);
+    EXPECT_TRUE(models.size() == 1)
+    if(models.empty())
+        return;
+    EXPECT_NEAR(planeDistance(models[0], constraintP0), 0.0, 1e-9)
+    EXPECT_NEAR(planeDistance(models[0], constraintP1), 0.0, 1e-9)
+    for(size_t i = 0; i < kernel.NumSamples(); ++i)
+        EXPECT_NEAR(kernel.Error(i, models[0]), 0.0, 1e-9)
+}
+
+/// Plane points with a small noise, followed by outliers uniformly drawn in the bounding box
+aliceVision::Mat makePlanePointsWithOutliers(const int inlierCount, const int outlierCount,
+                                            std::mt19937& generator)
+{
+    aliceVision::Mat points = makePlanePoints(inlierCount + outlierCount, generator);
+    std::normal_distribution<double> noise(0.0, 0.002);
+    std::uniform_real_distribution<double> z(0.5, 3.5);
+    for(int i = 0; i < inlierCount; ++i)
+        points(2, i) += noise(generator);
+    for(int i = inlierCount; i < points.cols(); ++i)
+        points(2, i) = z(generator);
+    return points;
+}
+
+/// Maximum distance from the points of the reference plane in [-1, 1] x [-1, 1] to the model
+double planeError(const aliceVision::Vec4& model)
+{
+    double maxDistance = 0.0;
+    for(int i = -1; i <= 1; i += 2)
+    {
+        for(int j = -1; j <= 1; j += 2)
+        {
+            const aliceVision::Vec3 corner(i, j, 0.5 * i - 0.25 * j + 2.0);
+            maxDistance = std::max(maxDistance, planeDistance(model, corner));
+        }
+    }
+    return maxDistance;
+}
+
+MVGPlaneEstimatorOptions makeOptions(const MVGPlaneEstimatorOptions::EMethod method)
+{
+    MVGPlaneEstimatorOptions options;
+    options.method = method;
+    options.seed = 1234;
+    return options;
+}
+
+const MVGPlaneEstimatorOptions::EMethod g_methods[] = {
+    MVGPlaneEstimatorOptions::kLMedS, MVGPlaneEstimatorOptions::kRansac,
+    MVGPlaneEstimatorOptions::kMsac};
+
+void testRequiredIterations()
+{
+    EXPECT_TRUE(MVGPlaneEstimator::requiredIterations(1.0, 3, 0.99, 1000) == 1)
+    EXPECT_TRUE(MVGPlaneEstimator::requiredIterations(0.0, 3, 0.99, 1000) == 1000)
+    // log(0.01) / log(1 - 0.5^3) = 34.5
+    EXPECT_TRUE(MVGPlaneEstimator::requiredIterations(0.5, 3, 0.99, 1000) == 35)
+    EXPECT_TRUE(MVGPlaneEstimator::requiredIterations(0.01, 3, 0.99, 1000) == 1000)
+}
+
+void testPlaneEstimatorWithOutliers()
+{
+    std::mt19937 generator(11);
+    const int inlierCount = 700;
+    const aliceVision::Mat points = makePlanePointsWithOutliers(inlierCount, 300, generator);
+    for(size_t m = 0; m < sizeof(g_methods) / sizeof(g_methods[0]); ++m)
+    {
+        const MVGPlaneEstimatorOptions options = makeOptions(g_methods[m]);
+        PlaneKernel::Model model;
+        EXPECT_TRUE(MVGGeometry::computePlane(points, model, options))
+        EXPECT_NEAR(planeError(model), 0.0, 0.01)
+        if(g_methods[m] == MVGPlaneEstimatorOptions::kLMedS)
+            continue;
+
+        // inliers are the plane points, up to outliers lying close to the plane
+        const PlaneKernel kernel(points);
+        MVGPlaneEstimator estimator(options);
+        std::vector<size_t> inliers;
+        EXPECT_TRUE(estimator.estimate(kernel, model, &inliers))
+        size_t truePositives = 0;
+        for(size_t i = 0; i < inliers.size(); ++i)
+            truePositives += (inliers[i] < static_cast<size_t>(inlierCount));
+        EXPECT_TRUE(truePositives == static_cast<size_t>(inlierCount))
+        EXPECT_TRUE(inliers.size() < static_cast<size_t>(inlierCount) + 30)
+
+        // same seed, same result
+        MVGPlaneEstimator sameSeedEstimator(options);
+        PlaneKernel::Model sameSeedModel;
+        std::vector<size_t> sameSeedInliers;
+        EXPECT_TRUE(sameSeedEstimator.estimate(kernel, sameSeedModel, &sameSeedInliers))
+        EXPECT_TRUE(sameSeedModel == model)
+        EXPECT_TRUE(sameSeedInliers == inliers)
+    }
+}
+
+void testPlaneEstimatorWithLineConstraint()
+{
+    std::mt19937 generator(13);
+    const aliceVision::Mat points = makePlanePointsWithOutliers(300, 100, generator);
+    // line of the plane z = 0.5 x - 0.25 y + 2, at y = 0
+    const aliceVision::Vec3 constraintP0(-1.0, 0.0, 1.5);
+    const aliceVision::Vec3 constraintP1(1.0, 0.0, 2.5);
+    for(size_t m = 0; m < sizeof(g_methods) / sizeof(g_methods[0]); ++m)
+    {
+        LineConstrainedPlaneKernel::Model model;
+        EXPECT_TRUE(MVGGeometry::computePlaneWithLineConstraint(
+            points, constraintP0, constraintP1, model, makeOptions(g_methods[m])))
+        EXPECT_NEAR(planeError(model), 0.0, 0.01)
+        EXPECT_NEAR(planeDistance(model, constraintP0), 0.0, 0.01)
+        EXPECT_NEAR(planeDistance(model, constraintP1), 0.0, 0.01)
+    }
+}
+
+void testPlaneEstimatorSubsampling()
+{
+    std::mt19937 generator(17);
+    const int inlierCount = 40000;
+    const aliceVision::Mat points = makePlanePointsWithOutliers(inlierCount, 10000, generator);
+    const PlaneKernel kernel(points);
+    for(size_t m = 1; m < sizeof(g_methods) / sizeof(g_methods[0]); ++m)
+    {
+        MVGPlaneEstimatorOptions options = makeOptions(g_methods[m]);
+        options.maxScoredPoints = 1000;
+        MVGPlaneEstimator estimator(options);
+        PlaneKernel::Model model;
+        std::vector<size_t> inliers;
+        EXPECT_TRUE(estimator.estimate(kernel, model, &inliers))
+        EXPECT_NEAR(planeError(model), 0.0, 0.01)
+        // inliers are taken from all the points, not only the scored ones
+        EXPECT_TRUE(inliers.size() >= static_cast<size_t>(inlierCount))
+        EXPECT_TRUE(inliers.size() < static_cast<size_t>(inlierCount) + 1000)
+    }
+}
+
+/// Identifiers of the count closest cameras, closest first, by sorting all of them
+std::vector<int> findNearestCameras(const std::vector<int>& ids, const aliceVision::Mat3X& centers,
+                                    const aliceVision::Mat3X& directions,
+                                    const aliceVision::Vec3& point,
+                                    const aliceVision::Vec3* direction,
+                                    const double directionWeight, const int count)
+{
+    std::vector<std::pair<double, int> > distances;
+    for(size_t i = 0; i < ids.size(); ++i)
+    {
+        double squaredDistance = (centers.col(i) - point).squaredNorm();
+        if(direction)
+            squaredDistance +=
+                directionWeight * directionWeight * (directions.col(i) - *direction).squaredNorm();
+        distances.push_back(std::make_pair(squaredDistance, ids[i]));
+    }
+    std::sort(distances.begin(), distances.end());
+    std::vector<int> nearest;
+    for(size_t i = 0; i < distances.size() && static_cast<int>(i) < count; ++i)
+        nearest.push_back(distances[i].second);
+    return nearest;
+}
+
+void testCameraIndex()
+{
+    std::mt19937 generator(19);
+    std::uniform_real_distribution<double> coordinate(-10.0, 10.0);
+    const int cameraCount = 200;
+    std::vector<int> ids(cameraCount);
+    aliceVision::Mat3X centers(3, cameraCount);
+    aliceVision::Mat3X directions(3, cameraCount);
+    for(int i = 0; i < cameraCount; ++i)
+    {
+        ids[i] = 1000 + 3 * i;
+        centers.col(i) << coordinate(generator), coordinate(generator), coordinate(generator);
+        directions.col(i) = aliceVision::Vec3(coordinate(generator), coordinate(generator),
+                                              coordinate(generator)).normalized();
+    }
+    MVGCameraIndex index;
+    index.build(ids, centers, directions);
+    EXPECT_TRUE(index.getCameraCount() == cameraCount)
+
+    // more cameras requested than indexed : all of them are returned
+    const int counts[] = {1, 7, cameraCount + 10};
+    const double directionWeight = 5.0;
+    std::vector<int> nearest;
+    for(int query = 0; query < 50; ++query)
+    {
+        const aliceVision::Vec3 point(coordinate(generator), coordinate(generator),
+                                      coordinate(generator));
+        const aliceVision::Vec3 direction =
+            aliceVision::Vec3(coordinate(generator), coordinate(generator), coordinate(generator))
+                .normalized();
+        for(size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+        {
+            index.findNearest(point, counts[c], nearest);
+            EXPECT_TRUE(nearest == findNearestCameras(ids, centers, directions, point, NULL, 0.0,
+                                                      counts[c]))
+            index.findNearest(point, direction, directionWeight, counts[c], nearest);
+            EXPECT_TRUE(nearest == findNearestCameras(ids, centers, directions, point, &direction,
+                                                      directionWeight, counts[c]))
+        }
+    }
+    index.findNearest(aliceVision::Vec3::Zero(), cameraCount + 10, nearest);
+    EXPECT_TRUE(static_cast<int>(nearest.size()) == cameraCount)
+
+    index.clear();
+    index.findNearest(aliceVision::Vec3::Zero(), 1, nearest);
+    EXPECT_TRUE(nearest.empty())
+}
+
+MVGObservationTable::Observation makeObservation(const int vertexId, const int cameraId,
+                                                 const double x, const double y)
+{
+    MVGObservationTable::Observation observation = {vertexId, cameraId, x, y};
+    return observation;
+}
+
+/// Table rows are sorted by vertex then camera, without duplicates
+bool isTableSorted(const MVGObservationTable& table)
+{
+    for(int i = 1; i < table.size(); ++i)
+    {
+        const MVGObservationTable::Observation& previous = table[i - 1];
+        const MVGObservationTable::Observation& current = table[i];
+        if(previous.vertexId > current.vertexId ||
+           (previous.vertexId == current.vertexId && previous.cameraId >= current.cameraId))
+            return false;
+    }
+    return true;
+}
+
+void testObservationTable()
+{
+    MVGObservationTable table;
+    table.setObservation(4, 1, 4.1, 4.1);
+    table.setObservation(2, 3, 2.3, 2.3);
+    table.setObservation(2, 1, 2.1, 2.1);
+
+    // unsorted input with duplicates : the last one is kept and existing rows are replaced
+    std::vector<MVGObservationTable::Observation> edits;
+    edits.push_back(makeObservation(3, 2, 0.0, 0.0));
+    edits.push_back(makeObservation(2, 3, 9.0, 9.0));
+    edits.push_back(makeObservation(1, 5, 1.5, 1.5));
+    edits.push_back(makeObservation(3, 2, 3.2, 3.2));
+    edits.push_back(makeObservation(2, 2, 2.2, 2.2));
+    table.setObservations(edits);
+    EXPECT_TRUE(table.size() == 6)
+    EXPECT_TRUE(isTableSorted(table))
+    double x = 0.0;
+    double y = 0.0;
+    EXPECT_TRUE(table.getObservation(3, 2, x, y))
+    EXPECT_NEAR(x, 3.2, 1e-12)
+    EXPECT_TRUE(table.getObservation(2, 3, x, y))
+    EXPECT_NEAR(y, 9.0, 1e-12)
+    EXPECT_TRUE(table.getObservation(4, 1, x, y))
+    EXPECT_NEAR(x, 4.1, 1e-12)
+    EXPECT_TRUE(!table.getObservation(4, 2, x, y))
+
+    const MVGObservationTable::Observation* observations = NULL;
+    EXPECT_TRUE(table.getObservations(2, observations) == 3)
+    EXPECT_TRUE(observations && observations[0].cameraId == 1 && observations[2].cameraId == 3)
+    EXPECT_TRUE(table.getObservations(5, observations) == 0)
+
+    std::vector<int> vertexIds(1, 2);
+    table.unsetObservations(vertexIds);
+    table.unsetObservation(4, 1);
+    EXPECT_TRUE(table.size() == 2)
+    EXPECT_TRUE(table.getObservations(2, observations) == 0)
+
+    // pack / unpack round trip
+    std::vector<double> packed;
+    table.pack(packed);
+    EXPECT_TRUE(packed.size() == 2 * MVGObservationTable::_PACKED_SIZE)
+    MVGObservationTable unpacked;
+    unpacked.unpack(&packed[0], static_cast<int>(packed.size()));
+    EXPECT_TRUE(unpacked.size() == 2)
+    EXPECT_TRUE(unpacked.getObservation(1, 5, x, y))
+    EXPECT_NEAR(x, 1.5, 1e-12)
+
+    // unsorted attribute content with duplicates, the first one being kept
+    const double unsortedPacked[] = {7, 1, 7.1, 7.1, 6, 2, 6.2, 6.2,
+                                     7, 1, 0.0, 0.0, 6, 0, 6.0, 6.0};
+    unpacked.unpack(unsortedPacked, sizeof(unsortedPacked) / sizeof(unsortedPacked[0]));
+    EXPECT_TRUE(unpacked.size() == 3)
+    EXPECT_TRUE(isTableSorted(unpacked))
+    EXPECT_TRUE(unpacked.getObservation(7, 1, x, y))
+    EXPECT_NEAR(x, 7.1, 1e-12)
+}
+
+std::vector<int> toVector(const int* values, const int count)
+{
+    return count > 0 ? std::vector<int>(values, values + count) : std::vector<int>();
+}
+
+void testVisibilityIndex()
+{
+    // (view id, feature id) per observation : views 30 and 10, view 20, none, views 20 30 10
+    const int sizes[] = {2, 1, 0, 3};
+    const int ids[] = {30, 0, 10, 0, 20, 1, 20, 2, 30, 1, 10, 1};
+    MVGVisibilityIndex index;
+    index.buildFromPoints(std::vector<int>(sizes, sizes + 4), std::vector<int>(ids, ids + 12));
+    EXPECT_TRUE(index.getPointCount() == 4)
+    EXPECT_TRUE(index.getCameraCount() == 3)
+    // slots sorted by view id
+    EXPECT_TRUE(index.getSlot(10) == 0 && index.getSlot(20) == 1 && index.getSlot(30) == 2)
+    EXPECT_TRUE(index.getSlot(15) == -1)
+    EXPECT_TRUE(index.getViewId(2) == 30)
+
+    const int* values = NULL;
+    int count = index.getCameraSlots(0, values);
+    EXPECT_TRUE(toVector(values, count) == std::vector<int>({0, 2}))
+    count = index.getCameraSlots(3, values);
+    EXPECT_TRUE(toVector(values, count) == std::vector<int>({0, 1, 2}))
+    EXPECT_TRUE(index.getCameraSlots(2, values) == 0)
+    EXPECT_TRUE(index.getCameraSlots(4, values) == 0)
+    count = index.getPoints(1, values);
+    EXPECT_TRUE(toVector(values, count) == std::vector<int>({1, 3}))
+    count = index.getPoints(2, values);
+    EXPECT_TRUE(toVector(values, count) == std::vector<int>({0, 3}))
+    EXPECT_TRUE(index.getPoints(3, values) == 0)
+
+    std::vector<int> countPerSlot;
+    index.countPointsPerCamera(std::vector<int>({0, 1, 2}), countPerSlot);
+    EXPECT_TRUE(countPerSlot == std::vector<int>({1, 1, 1}))
+
+    // built per camera : slots in insertion order, invalid points and cameras added twice ignored
+    const int points30[] = {3, 0};
+    const int points10[] = {-1, 2};
+    index.clear();
+    index.addCamera(30, points30, 2);
+    index.addCamera(10, points10, 2);
+    index.addCamera(30, points10, 2);
+    index.buildFromCameras();
+    EXPECT_TRUE(index.getCameraCount() == 2)
+    EXPECT_TRUE(index.getPointCount() == 4)
+    EXPECT_TRUE(index.getSlot(30) == 0 && index.getSlot(10) == 1)
+    count = index.getPoints(0, values);
+    EXPECT_TRUE(toVector(values, count) == std::vector<int>({0, 3}))
+    count = index.getCameraSlots(2, values);
+    EXPECT_TRUE(toVector(values, count) == std::vector<int>({1}))
+    EXPECT_TRUE(index.getCameraSlots(1, values) == 0)
+
+    // both directions agree on random visibility
+    std::mt19937 generator(23);
+    std::uniform_int_distribution<int> viewId(0, 49);
+    std::uniform_int_distribution<int> visibilitySize(0, 6);
+    std::vector<int> randomSizes(500);
+    std::vector<int> randomIds;
+    for(size_t i = 0; i < randomSizes.size(); ++i)
+    {
+        randomSizes[i] = visibilitySize(generator);
+        for(int j = 0; j < randomSizes[i]; ++j)
+        {
+            randomIds.push_back(viewId(generator) * 7);
+            randomIds.push_back(j);
+        }
+    }
+    index.buildFromPoints(randomSizes, randomIds);
+    int observationCount = 0;
+    for(int slot = 0; slot < index.getCameraCount(); ++slot)
+    {
+        const int* points = NULL;
+        const int pointCount = index.getPoints(slot, points);
+        observationCount += pointCount;
+        for(int i = 0; i < pointCount; ++i)
+        {
+            const int* slots = NULL;
+            const int slotCount = index.getCameraSlots(points[i], slots);
+            EXPECT_TRUE(std::binary_search(slots, slots + slotCount, slot))
+        }
+    }
+    EXPECT_TRUE(observationCount == static_cast<int>(randomIds.size()) / 2)
+}
+
+void testPointCoverage()
+{
+    std::mt19937 generator(29);
+    std::uniform_int_distribution<int> viewId(0, 19);
+    std::uniform_int_distribution<int> visibilitySize(0, 5);
+    std::vector<int> sizes(300);
+    std::vector<int> ids;
+    for(size_t i = 0; i < sizes.size(); ++i)
+    {
+        // distinct views per point
+        std::vector<int> views;
+        for(int j = 0; j < 5; ++j)
+            views.push_back(viewId(generator));
+        std::sort(views.begin(), views.end());
+        views.erase(std::unique(views.begin(), views.end()), views.end());
+        views.resize(std::min(static_cast<int>(views.size()), visibilitySize(generator)));
+        sizes[i] = static_cast<int>(views.size());
+        for(size_t j = 0; j < views.size(); ++j)
+        {
+            ids.push_back(views[j]);
+            ids.push_back(0);
+        }
+    }
+    MVGVisibilityIndex index;
+    index.buildFromPoints(sizes, ids);
+
+    // successive active sets, compared to a count from scratch
+    MVGPointCoverage coverage;
+    std::bernoulli_distribution isActive(0.4);
+    for(int step = 0; step < 20; ++step)
+    {
+        std::vector<char> isActivePerSlot(index.getCameraCount(), 0);
+        std::vector<int> slots(1, -1); // ignored
+        slots.push_back(index.getCameraCount());
+        for(int slot = 0; slot < index.getCameraCount(); ++slot)
+        {
+            isActivePerSlot[slot] = isActive(generator);
+            if(isActivePerSlot[slot])
+                slots.push_back(slot);
+        }
+        coverage.setActiveCameras(index, slots);
+        const std::vector<int>& coveragePerPoint = coverage.getCoveragePerPoint();
+        EXPECT_TRUE(static_cast<int>(coveragePerPoint.size()) == index.getPointCount())
+        bool isCountValid = true;
+        for(int pointId = 0; pointId < index.getPointCount(); ++pointId)
+        {
+            const int* pointSlots = NULL;
+            const int slotCount = index.getCameraSlots(pointId, pointSlots);
+            int count = 0;
+            for(int i = 0; i < slotCount; ++i)
+                count += isActivePerSlot[pointSlots[i]];
+            isCountValid = isCountValid && (coveragePerPoint[pointId] == count);
+        }
+        EXPECT_TRUE(isCountValid)
+    }
+    coverage.setActiveCameras(index, std::vector<int>());
+    EXPECT_TRUE(std::count(coverage.getCoveragePerPoint().begin(),
+                           coverage.getCoveragePerPoint().end(), 0) == index.getPointCount())
+
+    coverage.clear();
+    EXPECT_TRUE(coverage.getCoveragePerPoint().empty())
+}
+
+struct MVGTest
+{
+    const char* name;
+    void (*run)();
+};
+
+} // empty namespace
+
+int main(int argc, char** argv)
+{
+    const char* filter = (argc > 1) ? argv[1] : "";
+
+    const MVGTest tests[] = {{"computeProjectionMatrix", testComputeProjectionMatrix},
+                             {"triangulatePoint", testTriangulatePoint},
+                             {"viewAndCameraSpace", testViewAndCameraSpace},
+                             {"windingNumber", testWindingNumber},
+                             {"planeKernel", testPlaneKernel},
+                             {"lineConstrainedPlaneKernel", testLineConstrainedPlaneKernel},
+                             {"requiredIterations", testRequiredIterations},
+                             {"planeEstimatorWithOutliers", testPlaneEstimatorWithOutliers},
+                             {"planeEstimatorWithLineConstraint",
+                              testPlaneEstimatorWithLineConstraint},
+                             {"planeEstimatorSubsampling", testPlaneEstimatorSubsampling},
+                             {"cameraIndex", testCameraIndex},
+                             {"observationTable", testObservationTable},
+                             {"visibilityIndex", testVisibilityIndex},
+                             {"pointCoverage", testPointCoverage}};
+
+    int failedTests = 0;
+    for(size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); ++i)
+    {
+        if(!std::strstr(tests[i].name, filter))
+            continue;
+        const int failedChecks = g_failedChecks;
+        tests[i].run();
+        const bool passed = (g_failedChecks == failedChecks);
+        std::printf("%-32s %s\n", tests[i].name, passed ? "OK" : "FAILED");
+        if(!passed)
+            ++failedTests;
+    }
+    return failedTests;
+}